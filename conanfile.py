@@ -10,7 +10,7 @@ required_conan_version = ">=1.45.0"
 
 class GTlabLoggingConan(ConanFile):
     name = "gtlab-logging"
-    version = "4.4.2"
+    version = "5.0.0"
     license = "GTlab license"
     author = "Martin Siggel <martin.siggel@dlr.de>"
     url = "https://gitlab.dlr.de/at-twk/gtlab-logging"
@@ -0,0 +1,653 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logbinary.h"
+#include "gt_logging.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace gt;
+
+using MutexLocker = const std::lock_guard<std::mutex>;
+
+namespace
+{
+
+/// file signature
+constexpr char Magic[] = {'G', 'T', 'L', 'O', 'G', 'B'};
+/// version of the file format
+constexpr std::uint8_t Version = 1;
+
+//! Kinds of chunks in a binary log file
+enum ChunkKind : std::uint8_t
+{
+    FormatChunk = 1, // description of a statement (string table)
+    RecordChunk = 2  // arguments of a logged message
+};
+
+//! Returns 1 on little endian and 2 on big endian machines
+std::uint8_t byteOrder()
+{
+    std::uint16_t value = 1;
+    std::uint8_t first;
+    std::memcpy(&first, &value, 1);
+    return first == 1 ? 1 : 2;
+}
+
+std::tm
+localTime(std::time_t rawtime)
+{
+    std::tm timebuf;
+
+#ifdef _WIN32
+    localtime_s(&timebuf, &rawtime);
+#else
+    localtime_r(&rawtime, &timebuf);
+#endif
+
+    return timebuf;
+}
+
+//! Registry of all binary logging statements
+struct FormatRegistry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<log::BinaryFormat>> formats;
+    /// statements of inline functions may have several handles. Statements
+    /// expanded from a single macro share the line, thus their level and
+    /// module are part of the key.
+    std::map<std::tuple<std::string, std::string, int, int, std::string>,
+             std::uint32_t> ids;
+};
+
+FormatRegistry&
+formatRegistry()
+{
+    // never destroyed, as statements may be executed during shutdown
+    static auto* registry = new FormatRegistry;
+    return *registry;
+}
+
+//! Binary log file. Statements are described in the file once, before their
+//! first record. Chunks are collected in a buffer, filled blocks are written
+//! to the file by a writer thread, thus logging threads do not wait for the
+//! disk.
+struct BinaryLogFile
+{
+    /// size of the blocks written to the file
+    static constexpr std::size_t BlockSize = 64 * 1024;
+    /// maximum number of blocks waiting to be written. Logging threads wait
+    /// if the disk cannot keep up.
+    static constexpr std::size_t MaxPendingBlocks = 64;
+
+    /// serializes opening and closing the file
+    std::mutex controlMutex;
+    /// guards all members except the file
+    std::mutex mutex;
+    std::atomic<bool> isOpen{false};
+    std::string buffer;
+    std::vector<bool> described;
+
+    /// filled blocks, which are written by the writer thread
+    std::vector<std::string> pending;
+    /// written blocks, which are reused
+    std::vector<std::string> spare;
+    /// number of blocks handed to and written by the writer thread
+    std::uint64_t queued = 0;
+    std::uint64_t written = 0;
+    std::condition_variable wakeup;
+    std::condition_variable blocksWritten;
+    bool stopRequested = false;
+    std::thread writer;
+    /// accessed by the writer thread only while it is running
+    std::ofstream out;
+
+    template <typename T>
+    void put(T const& t)
+    {
+        buffer.append(reinterpret_cast<char const*>(&t), sizeof(T));
+    }
+
+    void put(std::string const& s)
+    {
+        put(static_cast<std::uint32_t>(s.size()));
+        buffer.append(s);
+    }
+
+    void describe(std::uint32_t id)
+    {
+        if (described.size() < id) described.resize(id, false);
+        if (described[id - 1]) return;
+
+        log::BinaryFormat const* format = log::detail::binaryFormat(id);
+        if (!format) return;
+
+        put(FormatChunk);
+        put(id);
+        put(static_cast<std::int32_t>(format->level));
+        put(static_cast<std::int32_t>(format->line));
+        put(format->file);
+        put(format->module);
+        put(format->format);
+        described[id - 1] = true;
+    }
+
+    //! Appends a record. Mutex must be locked
+    void write(std::unique_lock<std::mutex>& lock, std::uint32_t id,
+               std::time_t time, char const* data, std::size_t size)
+    {
+        if (id > described.size() || !described[id - 1]) describe(id);
+
+        // kind, id, time, size
+        char header[1 + 4 + 8 + 4];
+        auto time64 = static_cast<std::int64_t>(time);
+        auto size32 = static_cast<std::uint32_t>(size);
+        header[0] = static_cast<char>(RecordChunk);
+        std::memcpy(header + 1, &id, 4);
+        std::memcpy(header + 5, &time64, 8);
+        std::memcpy(header + 13, &size32, 4);
+
+        std::size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(header) + size);
+        std::memcpy(&buffer[offset], header, sizeof(header));
+        std::memcpy(&buffer[offset + sizeof(header)], data, size);
+
+        if (buffer.size() >= BlockSize) submit(lock);
+    }
+
+    //! Hands the buffer to the writer thread. Mutex must be locked
+    void submit(std::unique_lock<std::mutex>& lock)
+    {
+        if (buffer.empty()) return;
+
+        blocksWritten.wait(lock, [this](){
+            return pending.size() < MaxPendingBlocks;
+        });
+
+        pending.push_back(std::move(buffer));
+        ++queued;
+
+        if (!spare.empty())
+        {
+            buffer = std::move(spare.back());
+            spare.pop_back();
+        }
+        else
+        {
+            buffer = std::string{};
+            buffer.reserve(BlockSize * 2);
+        }
+        wakeup.notify_one();
+    }
+
+    //! Waits until all records were written. Mutex must be locked
+    void flush(std::unique_lock<std::mutex>& lock)
+    {
+        submit(lock);
+
+        std::uint64_t target = queued;
+        blocksWritten.wait(lock, [&](){ return written >= target; });
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            wakeup.wait(lock, [this](){
+                return stopRequested || !pending.empty();
+            });
+            if (pending.empty()) break;
+
+            std::vector<std::string> blocks;
+            blocks.swap(pending);
+
+            lock.unlock();
+            for (std::string const& block : blocks)
+            {
+                out.write(block.data(),
+                          static_cast<std::streamsize>(block.size()));
+            }
+            out.flush();
+            lock.lock();
+
+            written += blocks.size();
+            for (std::string& block : blocks)
+            {
+                if (spare.size() >= 2) break;
+                block.clear();
+                spare.push_back(std::move(block));
+            }
+            blocksWritten.notify_all();
+        }
+    }
+
+    //! Writes all records, stops the writer thread and closes the file
+    void close(std::unique_lock<std::mutex>& lock)
+    {
+        isOpen.store(false, std::memory_order_release);
+        if (!writer.joinable()) return;
+
+        submit(lock);
+        stopRequested = true;
+        wakeup.notify_one();
+
+        lock.unlock();
+        writer.join();
+        lock.lock();
+
+        out.close();
+    }
+};
+
+BinaryLogFile&
+binaryLogFile()
+{
+    static auto* file = new BinaryLogFile;
+    return *file;
+}
+
+//! Decoded argument of a binary record
+struct Value
+{
+    log::BinaryArgType type;
+    union
+    {
+        bool b;
+        char c;
+        short s;
+        unsigned short us;
+        int i;
+        unsigned int ui;
+        long long ll;
+        unsigned long long ull;
+        float f;
+        double d;
+        char const* cstr;
+    };
+    /// storage of strings
+    std::string str;
+
+    void const* address() const
+    {
+        switch (type)
+        {
+        case log::BinaryBool: return &b;
+        case log::BinaryChar: return &c;
+        case log::BinaryShort: return &s;
+        case log::BinaryUShort: return &us;
+        case log::BinaryInt: return &i;
+        case log::BinaryUInt: return &ui;
+        case log::BinaryLongLong: return &ll;
+        case log::BinaryULongLong: return &ull;
+        case log::BinaryFloat: return &f;
+        case log::BinaryDouble: return &d;
+        case log::BinaryString:
+        default: return &cstr;
+        }
+    }
+
+    using Writer = void(*)(log::Stream&, void const*);
+
+    Writer writer() const
+    {
+        using namespace log::detail;
+        switch (type)
+        {
+        case log::BinaryBool: return &writeFormatArg<bool>;
+        case log::BinaryChar: return &writeFormatArg<char>;
+        case log::BinaryShort: return &writeFormatArg<short>;
+        case log::BinaryUShort: return &writeFormatArg<unsigned short>;
+        case log::BinaryInt: return &writeFormatArg<int>;
+        case log::BinaryUInt: return &writeFormatArg<unsigned int>;
+        case log::BinaryLongLong: return &writeFormatArg<long long>;
+        case log::BinaryULongLong: return &writeFormatArg<unsigned long long>;
+        case log::BinaryFloat: return &writeFormatArg<float>;
+        case log::BinaryDouble: return &writeFormatArg<double>;
+        case log::BinaryString:
+        default: return &writeFormatArg<char const*>;
+        }
+    }
+};
+
+//! Returns the size of the payload of a type tag (0 if invalid)
+std::size_t payloadSize(std::uint8_t type)
+{
+    switch (type)
+    {
+    case log::BinaryBool: return sizeof(bool);
+    case log::BinaryChar: return sizeof(char);
+    case log::BinaryShort: case log::BinaryUShort: return 2;
+    case log::BinaryInt: case log::BinaryUInt: case log::BinaryFloat: return 4;
+    case log::BinaryLongLong: case log::BinaryULongLong:
+    case log::BinaryDouble: return 8;
+    case log::BinaryString: return sizeof(std::uint32_t);
+    default: return 0;
+    }
+}
+
+//! Decodes the arguments of a record. Returns false if the data is invalid
+bool decode(char const* data, std::size_t size, std::vector<Value>& values)
+{
+    char const* end = data + size;
+    while (data != end)
+    {
+        std::uint8_t type = static_cast<std::uint8_t>(*data++);
+        std::size_t n = payloadSize(type);
+        if (n == 0 || static_cast<std::size_t>(end - data) < n) return false;
+
+        values.emplace_back();
+        Value& value = values.back();
+        value.type = static_cast<log::BinaryArgType>(type);
+
+        if (type == log::BinaryBool)
+        {
+            value.b = *data++ != 0;
+            continue;
+        }
+        if (type != log::BinaryString)
+        {
+            // all members of the union start at its address
+            std::memcpy(const_cast<void*>(value.address()), data, n);
+            data += n;
+            continue;
+        }
+
+        std::uint32_t length;
+        std::memcpy(&length, data, n);
+        data += n;
+        if (static_cast<std::size_t>(end - data) < length) return false;
+        value.str.assign(data, length);
+        data += length;
+    }
+    return true;
+}
+
+//! Returns the number of replacement fields or -1 if the format is invalid
+int argumentCount(char const* fmt)
+{
+    int count = 0;
+    while (char const* brace = std::strpbrk(fmt, "{}"))
+    {
+        if (*brace == '}' || brace[1] == '{')
+        {
+            if (brace[1] != *brace) return -1;
+            fmt = brace + 2;
+            continue;
+        }
+
+        log::detail::FormatSpec spec{};
+        char const* end = log::detail::parseFormatSpec(brace + 1, spec);
+        if (!end) return -1;
+        ++count;
+        fmt = end + 1;
+    }
+    return count;
+}
+
+template <typename T>
+bool read(std::istream& in, T& t)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&t), sizeof(T)));
+}
+
+//! Reads a chunk of the given size, which is taken from the file. The buffer
+//! grows while reading, thus a corrupt size fails at the end of the stream
+//! instead of allocating the full size up front.
+template <typename Buffer>
+bool read(std::istream& in, Buffer& buffer, std::uint32_t size)
+{
+    constexpr std::size_t Step = 64 * 1024;
+
+    buffer.clear();
+    while (buffer.size() < size)
+    {
+        std::size_t offset = buffer.size();
+        std::size_t n = std::min<std::size_t>(Step, size - offset);
+        buffer.resize(offset + n);
+        if (!in.read(&buffer[offset], static_cast<std::streamsize>(n)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool read(std::istream& in, std::string& s)
+{
+    std::uint32_t size;
+    return read(in, size) && read(in, s, size);
+}
+
+} // namespace
+
+std::uint32_t
+log::detail::registerBinaryFormat(char const* format,
+                                  char const* file,
+                                  int line,
+                                  Level level,
+                                  char const* module)
+{
+    FormatRegistry& registry = formatRegistry();
+    MutexLocker lock(registry.mutex);
+
+    auto key = std::make_tuple(std::string{format}, std::string{file}, line,
+                               static_cast<int>(level), std::string{module});
+    auto iter = registry.ids.find(key);
+    if (iter != registry.ids.end()) return iter->second;
+
+    auto entry = std::make_unique<BinaryFormat>();
+    entry->format = format;
+    entry->file = file;
+    entry->line = line;
+    entry->level = level;
+    entry->module = module;
+    registry.formats.push_back(std::move(entry));
+
+    auto id = static_cast<std::uint32_t>(registry.formats.size());
+    registry.ids.emplace(std::move(key), id);
+    return id;
+}
+
+log::BinaryFormat const*
+log::detail::binaryFormat(std::uint32_t id)
+{
+    FormatRegistry& registry = formatRegistry();
+    MutexLocker lock(registry.mutex);
+
+    if (id == 0 || id > registry.formats.size()) return nullptr;
+    return registry.formats[id - 1].get();
+}
+
+bool
+log::detail::formatBinaryRecord(std::string const& format,
+                                char const* data,
+                                std::size_t size,
+                                std::string& message)
+{
+    std::vector<Value> values;
+    if (!decode(data, size, values)) return false;
+
+    int count = argumentCount(format.c_str());
+    if (count < 0 || static_cast<std::size_t>(count) != values.size())
+    {
+        return false;
+    }
+
+    std::vector<FormatArg> args;
+    args.reserve(values.size());
+    for (Value& value : values)
+    {
+        // the strings are no longer moved
+        if (value.type == BinaryString) value.cstr = value.str.c_str();
+        args.push_back(FormatArg{value.address(), value.writer()});
+    }
+
+    Stream s;
+    formatMessage(s, format.c_str(), args.data(), args.size());
+    message = s.message();
+    return true;
+}
+
+void
+log::detail::writeBinary(std::uint32_t format, Level level,
+                         char const* data, std::size_t size, std::time_t time,
+                         ThreadInfo const& thread)
+{
+    BinaryLogFile& file = binaryLogFile();
+    if (file.isOpen.load(std::memory_order_acquire))
+    {
+        std::unique_lock<std::mutex> lock(file.mutex);
+        if (file.isOpen.load(std::memory_order_relaxed))
+        {
+            file.write(lock, format, time, data, size);
+            return;
+        }
+    }
+
+    Logger::instance().logBinary(level, format, data, size, time, thread);
+}
+
+void
+log::detail::logBinary(std::uint32_t format, Level level,
+                       char const* data, std::size_t size)
+{
+    std::time_t rawtime;
+    std::time(&rawtime);
+
+    writeBinary(format, level, data, size, rawtime, currentThread());
+}
+
+bool
+log::Logger::openBinaryLog(std::string const& filePath)
+{
+    BinaryLogFile& file = binaryLogFile();
+    MutexLocker control(file.controlMutex);
+    std::unique_lock<std::mutex> lock(file.mutex);
+
+    file.close(lock);
+    file.described.clear();
+
+    file.out.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.out.is_open())
+    {
+        std::cerr << "GtLogging: failed to open binary log file '"
+                  << filePath << "'!\n";
+        return false;
+    }
+
+    file.buffer.reserve(BinaryLogFile::BlockSize * 2);
+    file.buffer.assign(Magic, sizeof(Magic));
+    file.put(Version);
+    file.put(byteOrder());
+
+    file.stopRequested = false;
+    file.writer = std::thread([&file](){ file.run(); });
+    file.isOpen.store(true, std::memory_order_release);
+    return true;
+}
+
+void
+log::Logger::closeBinaryLog()
+{
+    BinaryLogFile& file = binaryLogFile();
+    MutexLocker control(file.controlMutex);
+    std::unique_lock<std::mutex> lock(file.mutex);
+
+    file.close(lock);
+}
+
+void
+log::detail::flushBinaryLog()
+{
+    BinaryLogFile& file = binaryLogFile();
+    if (!file.isOpen.load(std::memory_order_acquire)) return;
+
+    std::unique_lock<std::mutex> lock(file.mutex);
+    if (file.isOpen.load(std::memory_order_relaxed)) file.flush(lock);
+}
+
+bool
+log::Logger::isBinaryLogOpen() const
+{
+    return binaryLogFile().isOpen.load(std::memory_order_acquire);
+}
+
+bool
+log::readBinaryLog(std::istream& in,
+                   std::function<void(std::string const&,
+                                      Level,
+                                      Details const&)> const& sink)
+{
+    char magic[sizeof(Magic)];
+    std::uint8_t version, order;
+    if (!in.read(magic, sizeof(magic)) ||
+        !std::equal(magic, magic + sizeof(magic), Magic) ||
+        !read(in, version) || version != Version ||
+        !read(in, order) || order != byteOrder())
+    {
+        return false;
+    }
+
+    std::map<std::uint32_t, BinaryFormat> formats;
+    std::vector<char> data;
+    std::string message;
+
+    std::uint8_t kind;
+    while (read(in, kind))
+    {
+        std::uint32_t id;
+        if (!read(in, id)) return false;
+
+        if (kind == FormatChunk)
+        {
+            BinaryFormat format;
+            std::int32_t level, line;
+            if (!read(in, level) || !read(in, line) ||
+                !read(in, format.file) || !read(in, format.module) ||
+                !read(in, format.format))
+            {
+                return false;
+            }
+            format.level = levelFromInt(level);
+            format.line = line;
+            formats[id] = std::move(format);
+            continue;
+        }
+
+        std::int64_t time;
+        std::uint32_t size;
+        if (kind != RecordChunk || !read(in, time) || !read(in, size))
+        {
+            return false;
+        }
+
+        if (!read(in, data, size)) return false;
+
+        auto iter = formats.find(id);
+        if (iter == formats.end()) return false;
+
+        BinaryFormat const& format = iter->second;
+        if (!detail::formatBinaryRecord(format.format, data.data(), size,
+                                        message))
+        {
+            return false;
+        }
+
+        sink(message, format.level,
+             Details{format.module, localTime(static_cast<std::time_t>(time)),
+                     detail::binaryLocation(format)});
+    }
+
+    return in.eof();
+}
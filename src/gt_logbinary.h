@@ -0,0 +1,335 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGBINARY_H
+#define GT_LOGBINARY_H
+
+#include "gt_logging_exports.h"
+#include "gt_loglevel.h"
+#include "gt_logformat.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <istream>
+#include <string>
+#include <type_traits>
+
+namespace gt
+{
+
+namespace log
+{
+
+//! Type tags of the arguments of a binary record
+enum BinaryArgType : std::uint8_t
+{
+    BinaryBool = 1,
+    BinaryChar,
+    BinaryShort,
+    BinaryUShort,
+    BinaryInt,
+    BinaryUInt,
+    BinaryLongLong,
+    BinaryULongLong,
+    BinaryFloat,
+    BinaryDouble,
+    BinaryString
+};
+
+//! Static description of a binary logging statement
+struct BinaryFormat
+{
+    /// format string
+    std::string format;
+    /// source file of the statement
+    std::string file;
+    /// line of the statement
+    int line = 0;
+    /// level of the statement
+    Level level = InfoLevel;
+    /// module id of the statement
+    std::string module;
+};
+
+/**
+ * @brief Reads a binary log file written by `Logger::openBinaryLog` and
+ * renders its records.
+ * @param in Input stream (opened in binary mode)
+ * @param sink Called with the formatted message of each record
+ * @return False if the stream is not a binary log or is corrupted. Records
+ * up to the corrupted part have been passed to the sink.
+ */
+GT_LOGGING_EXPORT
+bool readBinaryLog(std::istream& in,
+                   std::function<void(std::string const&,
+                                      Level,
+                                      Details const&)> const& sink);
+
+namespace detail
+{
+
+//! Returns the location of a binary logging statement. Points into the
+//! description, the function is unknown.
+inline SourceLocation binaryLocation(BinaryFormat const& format) noexcept
+{
+    char const* file = format.file.c_str();
+    return {file + fileNameOffset(file), format.line, ""};
+}
+
+//! Registers a binary logging statement. Returns its format id (> 0)
+GT_LOGGING_EXPORT
+std::uint32_t registerBinaryFormat(char const* format,
+                                   char const* file,
+                                   int line,
+                                   Level level,
+                                   char const* module);
+
+//! Returns the description of a binary logging statement or null if the
+//! format id is unknown
+GT_LOGGING_EXPORT
+BinaryFormat const* binaryFormat(std::uint32_t id);
+
+//! Renders the encoded arguments using the format string. Returns false if
+//! the arguments do not match the format string.
+GT_LOGGING_EXPORT
+bool formatBinaryRecord(std::string const& format,
+                        char const* data,
+                        std::size_t size,
+                        std::string& message);
+
+//! Writes the encoded arguments of a binary logging statement, either to the
+//! binary log file (if opened) or to the destinations. The thread is not
+//! stored in the binary log file.
+GT_LOGGING_EXPORT
+void writeBinary(std::uint32_t format, Level level,
+                 char const* data, std::size_t size, std::time_t time,
+                 ThreadInfo const& thread);
+
+//! Same as above, using the current time and thread
+GT_LOGGING_EXPORT
+void logBinary(std::uint32_t format, Level level,
+               char const* data, std::size_t size);
+
+//! Flushes the binary log file (if opened)
+GT_LOGGING_EXPORT
+void flushBinaryLog();
+
+//! Static handle of a binary logging statement. Holds the format id, which
+//! is assigned on first use.
+class BinaryFormatHandle
+{
+public:
+
+    constexpr BinaryFormatHandle(char const* format,
+                                 char const* file,
+                                 int line,
+                                 Level level,
+                                 char const* module) noexcept :
+        m_format{format},
+        m_file{file},
+        m_module{module},
+        m_line{line},
+        m_level{level}
+    {}
+
+    //! Returns the format id of the statement
+    std::uint32_t id()
+    {
+        std::uint32_t id = m_id.load(std::memory_order_acquire);
+        if (id != 0) return id;
+
+        id = registerBinaryFormat(m_format, m_file, m_line, m_level, m_module);
+        m_id.store(id, std::memory_order_release);
+        return id;
+    }
+
+    Level level() const noexcept { return m_level; }
+
+private:
+
+    char const* m_format;
+    char const* m_file;
+    char const* m_module;
+    int m_line;
+    Level m_level;
+    std::atomic<std::uint32_t> m_id{0};
+};
+
+//! Encoding of an argument type. Unsupported types are rejected by a static
+//! assertion in `logBinary`.
+template <typename T, typename Enable = void>
+struct BinaryArg
+{
+    static constexpr bool supported = false;
+    static constexpr std::size_t maxSize = 0;
+
+    static char* encode(char* out, T const&) noexcept { return out; }
+};
+
+template <typename T, BinaryArgType Type>
+struct BinaryValueArg
+{
+    static constexpr bool supported = true;
+    static constexpr std::size_t maxSize = 1 + sizeof(T);
+
+    static char* encode(char* out, T const& t) noexcept
+    {
+        *out++ = static_cast<char>(Type);
+        std::memcpy(out, &t, sizeof(T));
+        return out + sizeof(T);
+    }
+};
+
+template <> struct BinaryArg<bool> : BinaryValueArg<bool, BinaryBool> {};
+template <> struct BinaryArg<char> : BinaryValueArg<char, BinaryChar> {};
+template <> struct BinaryArg<float> : BinaryValueArg<float, BinaryFloat> {};
+template <> struct BinaryArg<double> : BinaryValueArg<double, BinaryDouble> {};
+
+//! Maps integers to the tag of the same size and signedness
+template <std::size_t Size, bool Signed>
+struct BinaryIntType;
+
+template <> struct BinaryIntType<2, true>
+{ using type = short; static constexpr BinaryArgType tag = BinaryShort; };
+template <> struct BinaryIntType<2, false>
+{ using type = unsigned short; static constexpr BinaryArgType tag = BinaryUShort; };
+template <> struct BinaryIntType<4, true>
+{ using type = int; static constexpr BinaryArgType tag = BinaryInt; };
+template <> struct BinaryIntType<4, false>
+{ using type = unsigned int; static constexpr BinaryArgType tag = BinaryUInt; };
+template <> struct BinaryIntType<8, true>
+{ using type = long long; static constexpr BinaryArgType tag = BinaryLongLong; };
+template <> struct BinaryIntType<8, false>
+{ using type = unsigned long long; static constexpr BinaryArgType tag = BinaryULongLong; };
+
+template <typename T>
+using BinaryIntOf = BinaryIntType<sizeof(T), std::is_signed<T>::value>;
+
+// integers (except for chars, bool and wide chars)
+template <typename T>
+struct BinaryArg<T, std::enable_if_t<
+        std::is_integral<T>::value && sizeof(T) >= 2 &&
+        !std::is_same<T, char16_t>::value &&
+        !std::is_same<T, char32_t>::value &&
+        !std::is_same<T, wchar_t>::value>>
+{
+    using type = typename BinaryIntOf<T>::type;
+
+    static constexpr bool supported = true;
+    static constexpr std::size_t maxSize = 1 + sizeof(T);
+
+    static char* encode(char* out, T const& t) noexcept
+    {
+        type value = static_cast<type>(t);
+        *out++ = static_cast<char>(BinaryIntOf<T>::tag);
+        std::memcpy(out, &value, sizeof(type));
+        return out + sizeof(type);
+    }
+};
+
+// enums are logged as their underlying value
+template <typename T>
+struct BinaryArg<T, std::enable_if_t<std::is_enum<T>::value>>
+{
+    using underlying = std::underlying_type_t<T>;
+
+    static constexpr bool supported = BinaryArg<underlying>::supported;
+    static constexpr std::size_t maxSize = BinaryArg<underlying>::maxSize;
+
+    static char* encode(char* out, T const& t) noexcept
+    {
+        return BinaryArg<underlying>::encode(out, static_cast<underlying>(t));
+    }
+};
+
+// character arrays (string literals) are copied until the first null
+template <std::size_t N>
+struct BinaryArg<char[N]>
+{
+    static constexpr bool supported = true;
+    static constexpr std::size_t maxSize = 1 + sizeof(std::uint32_t) + N;
+
+    static char* encode(char* out, char const(&t)[N]) noexcept
+    {
+        std::uint32_t size = 0;
+        while (size < N && t[size] != '\0') ++size;
+
+        *out++ = static_cast<char>(BinaryString);
+        std::memcpy(out, &size, sizeof(size));
+        out += sizeof(size);
+        std::memcpy(out, t, size);
+        return out + size;
+    }
+};
+
+constexpr std::size_t binaryRecordSize()
+{
+    return 0;
+}
+
+template <typename... Sizes>
+constexpr std::size_t binaryRecordSize(std::size_t size, Sizes... sizes)
+{
+    return size + binaryRecordSize(sizes...);
+}
+
+inline char* encodeBinaryArgs(char* out) noexcept
+{
+    return out;
+}
+
+template <typename T, typename... Args>
+inline char* encodeBinaryArgs(char* out, T const& t, Args const&... args) noexcept
+{
+    return encodeBinaryArgs(BinaryArg<T>::encode(out, t), args...);
+}
+
+template <typename... Ts>
+struct BinaryArgsSupported;
+
+template <>
+struct BinaryArgsSupported<> : std::true_type {};
+
+template <typename T, typename... Ts>
+struct BinaryArgsSupported<T, Ts...> :
+    std::integral_constant<bool, BinaryArg<T>::supported &&
+                                 BinaryArgsSupported<Ts...>::value> {};
+
+/**
+ * @brief Encodes the arguments of a binary logging statement into a
+ * buffer on the stack and writes the record. No formatting takes place.
+ * @param handle Static handle of the statement
+ * @param f Holds the format string as a constant expression
+ * @param fmt Format string
+ * @param args Arguments (trivially copyable)
+ */
+template <typename Fmt, std::size_t N, typename... Args>
+inline void logBinary(BinaryFormatHandle& handle, Fmt f,
+                      char const(&fmt)[N], Args const&... args)
+{
+    (void)FormatCheck<validateFormat(Fmt::value(),
+                                     FormatTypeList<Args...>{})>{};
+    static_assert(BinaryArgsSupported<Args...>::value,
+                  "gtLogging: binary logging statements accept arithmetic "
+                  "values, enums and string literals only");
+    (void)f;
+    (void)fmt;
+
+    // one additional byte for empty argument lists
+    char buffer[binaryRecordSize(BinaryArg<Args>::maxSize..., 1)];
+    char* end = encodeBinaryArgs(buffer, args...);
+
+    logBinary(handle.id(), handle.level(), buffer,
+              static_cast<std::size_t>(end - buffer));
+}
+
+} // namespace detail
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGBINARY_H
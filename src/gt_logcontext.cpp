@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logcontext.h"
+
+using namespace gt;
+
+namespace
+{
+
+/// innermost entry of the calling thread
+thread_local std::shared_ptr<log::detail::ContextNode const> current;
+
+} // namespace
+
+log::Context
+log::currentContext() noexcept
+{
+    return Context{current};
+}
+
+log::Context
+log::detail::pushContext(std::string key, std::string value)
+{
+    auto node = std::make_shared<ContextNode>();
+    node->key = std::move(key);
+    node->value = std::move(value);
+    node->parent = current;
+
+    Context previous{std::move(current)};
+    current = std::move(node);
+    return previous;
+}
+
+void
+log::detail::popContext(Context previous) noexcept
+{
+    current = previous.node();
+}
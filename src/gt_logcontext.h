@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGCONTEXT_H
+#define GT_LOGCONTEXT_H
+
+#include "gt_logging_exports.h"
+#include "gt_loglevel.h"
+#include "gt_logstream.h"
+
+#include <string>
+
+namespace gt
+{
+
+namespace log
+{
+
+//! Returns the diagnostic context of the calling thread. Does not allocate,
+//! the snapshot is shared with the enclosing scopes.
+GT_LOGGING_EXPORT
+Context currentContext() noexcept;
+
+namespace detail
+{
+
+//! Makes the entry the innermost one of the calling thread's context and
+//! returns the previous snapshot
+GT_LOGGING_EXPORT
+Context pushContext(std::string key, std::string value);
+
+//! Restores a snapshot returned by `pushContext`
+GT_LOGGING_EXPORT
+void popContext(Context previous) noexcept;
+
+} // namespace detail
+
+/**
+ * @brief RAII scope, that adds a key/value pair to the diagnostic context of
+ * the calling thread. The context is attached to all records emitted inside
+ * the scope (see `Details::context`). The value is formatted once when
+ * entering the scope, logging statements only share the resulting snapshot.
+ *
+ * gt::log::ScopedContext ctx{"task", taskId};
+ * gtInfo() << "started"; // Details::context holds "task"
+ *
+ * Scopes must be destroyed in reverse order on the thread that created them.
+ */
+class ScopedContext
+{
+public:
+
+    template <typename T>
+    ScopedContext(std::string key, T const& value) :
+        m_previous(detail::pushContext(std::move(key), format(value)))
+    {}
+
+    ~ScopedContext() { detail::popContext(std::move(m_previous)); }
+
+    ScopedContext(ScopedContext const&) = delete;
+    ScopedContext& operator=(ScopedContext const&) = delete;
+
+private:
+
+    Context m_previous;
+
+    template <typename T>
+    static std::string format(T const& value)
+    {
+        Stream stream;
+        stream.nospace() << value;
+        return stream.message();
+    }
+
+    static std::string format(std::string const& value) { return value; }
+};
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGCONTEXT_H
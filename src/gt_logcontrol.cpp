@@ -0,0 +1,518 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logcontrol.h"
+#include "gt_loghash.h"
+#include "gt_logging.h"
+
+#include <mutex>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+using MutexLocker = const std::lock_guard<std::mutex>;
+
+// constant initialized, thus valid before any dynamic initialization
+gt::log::detail::ControlBlock gt::log::detail::controlBlock;
+
+namespace gt
+{
+namespace log
+{
+
+namespace
+{
+
+/// overrides of the calling thread (trivially initialized)
+thread_local int threadLevel = detail::NoOverride;
+thread_local int threadVerbosityLevel = detail::NoOverride;
+
+//! Returns whether the module id matches the pattern. Returns the number of
+//! matching characters or -1. Exact matches take precedence over any prefix.
+int
+matchModule(std::string const& pattern, std::string const& id)
+{
+    if (!pattern.empty() && pattern.back() == '*')
+    {
+        size_t n = pattern.size() - 1;
+        if (id.compare(0, n, pattern, 0, n) != 0) return -1;
+        return static_cast<int>(n);
+    }
+    return pattern == id ? std::numeric_limits<int>::max() : -1;
+}
+
+//! Returns whether the path ends with the given file name or path
+bool
+matchFile(std::string const& file, std::string const& path)
+{
+    if (file.size() > path.size()) return false;
+
+    size_t offset = path.size() - file.size();
+    if (path.compare(offset, file.size(), file) != 0) return false;
+
+    return offset == 0 || path[offset - 1] == '/' || path[offset - 1] == '\\';
+}
+
+//! Module specific logging level
+struct ModuleRule
+{
+    std::string pattern;
+    int level;
+};
+
+//! Module specific sampling rate
+struct SamplingRule
+{
+    std::string pattern;
+    double rate;
+};
+
+//! Mode of all logging statements matched by the filter
+struct CallSiteRule
+{
+    CallSiteFilter filter;
+    CallSiteMode mode;
+
+    bool hasFilter(CallSiteFilter const& other) const
+    {
+        return filter.file == other.file &&
+               filter.firstLine == other.firstLine &&
+               filter.lastLine == other.lastLine &&
+               filter.module == other.module;
+    }
+
+    bool matches(CallSite const& site) const
+    {
+        return (filter.file.empty() || matchFile(filter.file, site.file)) &&
+               site.line >= filter.firstLine &&
+               site.line <= filter.lastLine &&
+               (filter.module.empty() ||
+                matchModule(filter.module, site.module) >= 0);
+    }
+};
+
+//! Registered logging statement
+struct CallSiteData
+{
+    CallSite info;
+    detail::CallSiteEntry entry;
+};
+
+//! Registry of all module levels and logging statements
+struct ControlRegistry
+{
+    std::mutex mutex;
+    /// incremented whenever a logging level changes, invalidates the
+    /// module levels cached by the threads
+    std::atomic<unsigned> generation{0};
+    std::vector<ModuleRule> moduleRules;
+    std::vector<SamplingRule> samplingRules;
+    std::vector<CallSiteRule> siteRules;
+    std::map<std::tuple<std::string, int, int, std::string>,
+             std::unique_ptr<CallSiteData>> sites;
+
+    //! Resolves the logging level of a module
+    int resolve(std::string const& id) const
+    {
+        int level = detail::controlBlock.level.load(std::memory_order_relaxed);
+        int best = -1;
+        for (ModuleRule const& rule : moduleRules)
+        {
+            int m = matchModule(rule.pattern, id);
+            if (m > best)
+            {
+                best = m;
+                level = rule.level;
+            }
+        }
+        return level;
+    }
+
+    //! Resolves the sampling rate of a module
+    double resolveSampling(std::string const& id) const
+    {
+        double rate = detail::NoSamplingRate;
+        int best = -1;
+        for (SamplingRule const& rule : samplingRules)
+        {
+            int m = matchModule(rule.pattern, id);
+            if (m > best)
+            {
+                best = m;
+                rate = rule.rate;
+            }
+        }
+        return rate;
+    }
+
+    //! Updates the state of a logging statement. Registry must be locked
+    void update(CallSiteData& site) const
+    {
+        int threshold = resolve(site.info.module);
+        switch (site.info.mode)
+        {
+        case CallSiteEnabled:
+            threshold = std::numeric_limits<int>::min();
+            break;
+        case CallSiteDisabled:
+            threshold = std::numeric_limits<int>::max();
+            break;
+        case CallSiteDefault:
+            break;
+        }
+        site.entry.threshold.store(threshold, std::memory_order_relaxed);
+        site.entry.mode.store(site.info.mode, std::memory_order_relaxed);
+        site.entry.samplingRate.store(resolveSampling(site.info.module),
+                                      std::memory_order_relaxed);
+    }
+
+    //! Updates all logging statements. Registry must be locked
+    void update()
+    {
+        generation.fetch_add(1, std::memory_order_release);
+
+        detail::controlBlock.moduleRules.store(
+            static_cast<int>(moduleRules.size()), std::memory_order_relaxed);
+
+        for (auto& site : sites) update(*site.second);
+    }
+};
+
+ControlRegistry&
+registry()
+{
+    // never destroyed, as logging statements may be executed during shutdown
+    static ControlRegistry* instance = new ControlRegistry;
+    return *instance;
+}
+
+} // namespace
+
+detail::CallSiteEntry const&
+detail::registerCallSite(char const* file, int line,
+                         Level level, char const* module)
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    auto& site = reg.sites[std::make_tuple(std::string{file}, line,
+                                           static_cast<int>(level),
+                                           std::string{module})];
+    if (!site)
+    {
+        site = std::make_unique<CallSiteData>();
+        site->info.file = file;
+        site->info.line = line;
+        site->info.level = level;
+        site->info.module = module;
+        site->entry.module = site->info.module.c_str();
+
+        for (CallSiteRule const& rule : reg.siteRules)
+        {
+            if (rule.matches(site->info)) site->info.mode = rule.mode;
+        }
+        reg.update(*site);
+    }
+    return site->entry;
+}
+
+bool
+detail::isModuleLevelEnabled(char const* id, Level level)
+{
+    //! Resolved logging levels of the module ids logged by the calling thread.
+    //! Open addressing table, thus looking up an id neither allocates nor
+    //! constructs a string.
+    struct ModuleLevelCache
+    {
+        struct Slot
+        {
+            std::uint64_t hash = 0;
+            bool used = false;
+            int level = 0;
+            /// keeps its capacity when the slot is reused
+            std::string id;
+        };
+
+        unsigned generation = 0;
+        size_t size = 0;
+        std::array<Slot, 128> slots;
+    };
+    // limits the cache if ids are generated dynamically, keeps half of the
+    // slots free
+    constexpr size_t maxCachedModules = 64;
+
+    thread_local ModuleLevelCache cache;
+
+    ControlRegistry& reg = registry();
+    unsigned generation = reg.generation.load(std::memory_order_acquire);
+    if (cache.generation != generation || cache.size >= maxCachedModules)
+    {
+        for (auto& slot : cache.slots) slot.used = false;
+        cache.size = 0;
+        cache.generation = generation;
+    }
+
+    detail::Hasher hasher;
+    hasher.update(id, std::strlen(id));
+    std::uint64_t hash = hasher.digest();
+
+    size_t const mask = cache.slots.size() - 1;
+    size_t i = static_cast<size_t>(hash) & mask;
+    for (; cache.slots[i].used; i = (i + 1) & mask)
+    {
+        auto const& slot = cache.slots[i];
+        if (slot.hash == hash && slot.id == id) return slot.level <= level;
+    }
+
+    auto& slot = cache.slots[i];
+    slot.id = id;
+    {
+        MutexLocker lock(reg.mutex);
+        slot.level = reg.resolve(slot.id);
+    }
+    slot.hash = hash;
+    slot.used = true;
+    ++cache.size;
+    return slot.level <= level;
+}
+
+int
+detail::threadLoggingLevel() noexcept
+{
+    return threadLevel;
+}
+
+int
+detail::threadVerbosity() noexcept
+{
+    return threadVerbosityLevel;
+}
+
+ScopedLevel::ScopedLevel(Level level) :
+    m_previous(threadLevel)
+{
+    threadLevel = level;
+    detail::controlBlock.overrides.fetch_add(1, std::memory_order_relaxed);
+}
+
+ScopedLevel::~ScopedLevel()
+{
+    threadLevel = m_previous;
+    detail::controlBlock.overrides.fetch_sub(1, std::memory_order_relaxed);
+}
+
+ScopedVerbosity::ScopedVerbosity(int verbosity) :
+    m_previous(threadVerbosityLevel)
+{
+    threadVerbosityLevel = verbosity;
+    detail::controlBlock.overrides.fetch_add(1, std::memory_order_relaxed);
+}
+
+ScopedVerbosity::~ScopedVerbosity()
+{
+    threadVerbosityLevel = m_previous;
+    detail::controlBlock.overrides.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void
+Logger::setLoggingLevel(Level newLevel)
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    detail::controlBlock.level.store(newLevel, std::memory_order_relaxed);
+    reg.update();
+}
+
+Level
+Logger::loggingLevel() const
+{
+    return levelFromInt(
+        detail::controlBlock.level.load(std::memory_order_relaxed));
+}
+
+void
+Logger::setModuleLoggingLevel(std::string const& module, Level newLevel)
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    auto iter = std::find_if(reg.moduleRules.begin(), reg.moduleRules.end(),
+                             [&](ModuleRule const& rule){
+        return rule.pattern == module;
+    });
+
+    if (iter != reg.moduleRules.end())
+    {
+        iter->level = newLevel;
+    }
+    else
+    {
+        reg.moduleRules.push_back({module, newLevel});
+    }
+    reg.update();
+}
+
+bool
+Logger::removeModuleLoggingLevel(std::string const& module)
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    auto iter = std::remove_if(reg.moduleRules.begin(), reg.moduleRules.end(),
+                               [&](ModuleRule const& rule){
+        return rule.pattern == module;
+    });
+
+    if (iter == reg.moduleRules.end()) return false;
+
+    reg.moduleRules.erase(iter, reg.moduleRules.end());
+    reg.update();
+    return true;
+}
+
+void
+Logger::clearModuleLoggingLevels()
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    reg.moduleRules.clear();
+    reg.update();
+}
+
+Level
+Logger::moduleLoggingLevel(std::string const& module) const
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    return levelFromInt(reg.resolve(module));
+}
+
+void
+Logger::setModuleSamplingRate(std::string const& module, double rate)
+{
+    rate = std::min(std::max(rate, 0.0), 1.0);
+
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    auto iter = std::find_if(reg.samplingRules.begin(),
+                             reg.samplingRules.end(),
+                             [&](SamplingRule const& rule){
+        return rule.pattern == module;
+    });
+
+    if (iter != reg.samplingRules.end())
+    {
+        iter->rate = rate;
+    }
+    else
+    {
+        reg.samplingRules.push_back({module, rate});
+    }
+    reg.update();
+}
+
+bool
+Logger::removeModuleSamplingRate(std::string const& module)
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    auto iter = std::remove_if(reg.samplingRules.begin(),
+                               reg.samplingRules.end(),
+                               [&](SamplingRule const& rule){
+        return rule.pattern == module;
+    });
+
+    if (iter == reg.samplingRules.end()) return false;
+
+    reg.samplingRules.erase(iter, reg.samplingRules.end());
+    reg.update();
+    return true;
+}
+
+void
+Logger::clearModuleSamplingRates()
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    reg.samplingRules.clear();
+    reg.update();
+}
+
+size_t
+Logger::setCallSiteMode(CallSiteFilter const& filter, CallSiteMode mode)
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    // replaces the rule of an identical filter, thus toggling statements
+    // repeatedly does not accumulate rules
+    reg.siteRules.erase(std::remove_if(reg.siteRules.begin(),
+                                       reg.siteRules.end(),
+                                       [&](CallSiteRule const& rule){
+        return rule.hasFilter(filter);
+    }), reg.siteRules.end());
+
+    CallSiteRule rule{filter, mode};
+    reg.siteRules.push_back(rule);
+
+    size_t count = 0;
+    for (auto& site : reg.sites)
+    {
+        CallSiteData& data = *site.second;
+        if (!rule.matches(data.info)) continue;
+
+        data.info.mode = mode;
+        reg.update(data);
+        ++count;
+    }
+    return count;
+}
+
+void
+Logger::clearCallSiteModes()
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    reg.siteRules.clear();
+    for (auto& site : reg.sites) site.second->info.mode = CallSiteDefault;
+    reg.update();
+}
+
+std::vector<CallSite>
+Logger::callSites() const
+{
+    ControlRegistry& reg = registry();
+    MutexLocker lock(reg.mutex);
+
+    std::vector<CallSite> sites;
+    sites.reserve(reg.sites.size());
+    for (auto const& site : reg.sites) sites.push_back(site.second->info);
+    return sites;
+}
+
+void
+Logger::setVerbosity(int verbosity)
+{
+    detail::controlBlock.verbosity.store(verbosity, std::memory_order_relaxed);
+}
+
+int
+Logger::verbosity() const
+{
+    return detail::controlBlock.verbosity.load(std::memory_order_relaxed);
+}
+
+} // namespace log
+
+} // namespace gt
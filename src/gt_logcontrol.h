@@ -0,0 +1,326 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGCONTROL_H
+#define GT_LOGCONTROL_H
+
+#include "gt_loglevel.h"
+
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <string>
+
+namespace gt
+{
+
+namespace log
+{
+
+//! Runtime mode of a logging statement
+enum CallSiteMode
+{
+    /// the statement follows the logging level of its module
+    CallSiteDefault = 0,
+    /// the statement is always logged
+    CallSiteEnabled = 1,
+    /// the statement is never logged
+    CallSiteDisabled = 2
+};
+
+namespace detail
+{
+
+//! Global state that is checked by every logging statement. It is exported
+//! as a plain object, so that the checks can be inlined and cost a single
+//! relaxed load each. Use the setters of gt::log::Logger to modify it.
+struct ControlBlock
+{
+    /// logging level
+    std::atomic<int> level{InfoLevel};
+    /// verbosity level
+    std::atomic<int> verbosity{Silent};
+    /// number of module specific logging levels
+    std::atomic<int> moduleRules{0};
+    /// number of active thread specific overrides (see `ScopedLevel`)
+    std::atomic<int> overrides{0};
+    /// highest level dropped by the log budget, 0 if none
+    std::atomic<int> shedLevel{0};
+};
+
+GT_LOGGING_DATA_EXPORT extern ControlBlock controlBlock;
+
+/// denotes that the calling thread does not override a value
+constexpr int NoOverride = INT_MIN;
+
+//! Returns the logging level of the calling thread or `NoOverride`
+GT_LOGGING_EXPORT
+int threadLoggingLevel() noexcept;
+
+//! Returns the verbosity of the calling thread or `NoOverride`
+GT_LOGGING_EXPORT
+int threadVerbosity() noexcept;
+
+//! Returns whether any thread overrides the logging level or verbosity. The
+//! thread specific values are only looked up if this is the case.
+inline bool hasThreadOverrides() noexcept
+{
+    return controlBlock.overrides.load(std::memory_order_relaxed) != 0;
+}
+
+//! Returns whether a message of the given level exceeds the log budget and
+//! counts it as dropped. Stops shedding the level if the budget was
+//! refilled.
+GT_LOGGING_EXPORT
+bool isBudgetExceeded(Level level) noexcept;
+
+//! Returns whether messages of the given level are dropped by the log
+//! budget. The budget is only looked up if it sheds the level, thus
+//! dropped statements do not build their message.
+inline bool isShedByBudget(Level level) noexcept
+{
+    return level <= controlBlock.shedLevel.load(std::memory_order_relaxed) &&
+           isBudgetExceeded(level);
+}
+
+//! Returns whether the logging level admits messages of the given level
+inline bool isLevelAdmitted(Level level) noexcept
+{
+    if (hasThreadOverrides())
+    {
+        int value = threadLoggingLevel();
+        if (value != NoOverride) return value <= level;
+    }
+    return controlBlock.level.load(std::memory_order_relaxed) <= level;
+}
+
+//! Returns whether messages of the given level should be logged
+inline bool isLevelEnabled(Level level) noexcept
+{
+    return isLevelAdmitted(level) && !isShedByBudget(level);
+}
+
+//! Returns whether messages of the given verbosity should be logged
+inline bool isVerbosityEnabled(int verbosity) noexcept
+{
+    if (hasThreadOverrides())
+    {
+        int value = threadVerbosity();
+        if (value != NoOverride) return verbosity <= value;
+    }
+    return verbosity <= controlBlock.verbosity.load(std::memory_order_relaxed);
+}
+
+//! Returns whether messages of the given level should be logged for the
+//! module. Looks up the module specific levels, which are cached per thread
+//! until a logging level changes.
+GT_LOGGING_EXPORT
+bool isModuleLevelEnabled(char const* id, Level level);
+
+//! Returns whether messages of the given level should be logged for a module
+//! id, which is not known at compile time
+inline bool isModuleEnabled(char const* id, Level level)
+{
+    if (hasThreadOverrides())
+    {
+        int value = threadLoggingLevel();
+        if (value != NoOverride) return value <= level;
+    }
+    if (controlBlock.moduleRules.load(std::memory_order_relaxed) == 0)
+    {
+        return controlBlock.level.load(std::memory_order_relaxed) <= level;
+    }
+    return isModuleLevelEnabled(id, level);
+}
+
+inline bool isModuleEnabled(std::string const& id, Level level)
+{
+    return isModuleEnabled(id.c_str(), level);
+}
+
+inline char const* moduleId(char const* id) noexcept { return id; }
+inline char const* moduleId(std::string const& id) noexcept { return id.c_str(); }
+
+/// denotes that no sampling rate was set for the module of a statement
+constexpr double NoSamplingRate = -1.0;
+
+//! Runtime state of a logging statement. Entries are owned by the logger and
+//! are never destroyed, thus they remain valid even if the library that
+//! registered them is unloaded.
+struct CallSiteEntry
+{
+    /// effective logging level of the statement. Includes the mode, thus
+    /// the default check is a single load.
+    std::atomic<int> threshold{InfoLevel};
+    /// mode of the statement
+    std::atomic<int> mode{CallSiteDefault};
+    /// sampling rate of the module or `NoSamplingRate`
+    std::atomic<double> samplingRate{NoSamplingRate};
+    /// module id the statement was registered with. The threshold applies to
+    /// this module only.
+    char const* module = "";
+};
+
+//! Registers a logging statement. Returns the existing entry if the
+//! statement was registered before (e.g. by another translation unit).
+GT_LOGGING_EXPORT
+CallSiteEntry const& registerCallSite(char const* file, int line,
+                                      Level level, char const* module);
+
+//! Descriptor of a logging statement. Each logging macro owns a constant
+//! initialized handle, which is registered on its first execution.
+class CallSiteHandle
+{
+public:
+
+    constexpr CallSiteHandle(char const* file, int line, Level level,
+                             char const* module) noexcept :
+        m_file(file), m_module(module), m_line(line), m_level(level)
+    {}
+
+    //! Returns the entry of the statement. Registers it if necessary using
+    //! the given module id.
+    CallSiteEntry const& entry(char const* module)
+    {
+        CallSiteEntry const* e = m_entry.load(std::memory_order_acquire);
+        if (!e)
+        {
+            e = &registerCallSite(m_file, m_line, m_level, module);
+            m_entry.store(e, std::memory_order_release);
+        }
+        return *e;
+    }
+
+    //! Returns whether the statement should be logged. The logging level of
+    //! the calling thread does not apply to enabled or disabled statements.
+    bool isEnabled()
+    {
+        return isAdmitted() && !isShedByBudget(m_level);
+    }
+
+    //! Returns the sampling rate of the module of the statement or
+    //! `NoSamplingRate`
+    double samplingRate()
+    {
+        return entry(m_module).samplingRate.load(std::memory_order_relaxed);
+    }
+
+    //! Returns whether the statement should be logged for a module id, which
+    //! is not known at compile time. The id is used when the statement is
+    //! registered.
+    template <typename Id>
+    bool isEnabled(Id const& id)
+    {
+        return isAdmitted(id) && !isShedByBudget(m_level);
+    }
+
+private:
+
+    char const* m_file;
+    char const* m_module;
+    int m_line;
+    Level m_level;
+    std::atomic<CallSiteEntry const*> m_entry{nullptr};
+
+    //! Returns whether the mode and the logging levels admit the statement
+    bool isAdmitted()
+    {
+        CallSiteEntry const& e = entry(m_module);
+        if (hasThreadOverrides() &&
+            e.mode.load(std::memory_order_relaxed) == CallSiteDefault)
+        {
+            int value = threadLoggingLevel();
+            if (value != NoOverride) return value <= m_level;
+        }
+        return e.threshold.load(std::memory_order_relaxed) <= m_level;
+    }
+
+    //! Same as above, for a module id, which is not known at compile time
+    template <typename Id>
+    bool isAdmitted(Id const& id)
+    {
+        CallSiteEntry const& e = entry(moduleId(id));
+        int mode = e.mode.load(std::memory_order_relaxed);
+        if (mode != CallSiteDefault) return mode == CallSiteEnabled;
+
+        // usually statements are executed with the same id, thus the
+        // threshold of the entry applies
+        if (!hasThreadOverrides() &&
+            std::strcmp(e.module, moduleId(id)) == 0)
+        {
+            return e.threshold.load(std::memory_order_relaxed) <= m_level;
+        }
+        return isModuleEnabled(id, m_level);
+    }
+};
+
+//! Returns whether a statement logged once per call site should be logged,
+//! i.e. it has not been logged yet and is enabled. Marks the statement as
+//! logged. Once logged, the check is a single relaxed load.
+inline bool isFirstAtSite(std::atomic<bool>& logged, CallSiteHandle& site)
+{
+    if (logged.load(std::memory_order_relaxed)) return false;
+    return site.isEnabled() && !logged.exchange(true, std::memory_order_relaxed);
+}
+
+//! Same as above, but for module ids that are passed explicitly
+template <typename Id>
+inline bool isFirstAtSite(std::atomic<bool>& logged, CallSiteHandle& site,
+                          Id const& id)
+{
+    if (logged.load(std::memory_order_relaxed)) return false;
+    return site.isEnabled(id) &&
+           !logged.exchange(true, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+/**
+ * @brief RAII scope, that overrides the logging level of the calling thread,
+ * e.g. to log the debug messages of a single task only. Other threads keep
+ * logging at the global level. The override replaces the global and the
+ * module specific levels, statements that were enabled or disabled
+ * explicitly (see `Logger::setCallSiteMode`) are not affected.
+ *
+ * gt::log::ScopedLevel lvl{gt::log::DebugLevel};
+ *
+ * Scopes may be nested and must be destroyed on the thread that created
+ * them.
+ */
+class GT_LOGGING_EXPORT ScopedLevel
+{
+public:
+
+    explicit ScopedLevel(Level level);
+    ~ScopedLevel();
+
+    ScopedLevel(ScopedLevel const&) = delete;
+    ScopedLevel& operator=(ScopedLevel const&) = delete;
+
+private:
+
+    int m_previous;
+};
+
+//! RAII scope, that overrides the verbosity of the calling thread (see
+//! `ScopedLevel`)
+class GT_LOGGING_EXPORT ScopedVerbosity
+{
+public:
+
+    explicit ScopedVerbosity(int verbosity);
+    ~ScopedVerbosity();
+
+    ScopedVerbosity(ScopedVerbosity const&) = delete;
+    ScopedVerbosity& operator=(ScopedVerbosity const&) = delete;
+
+private:
+
+    int m_previous;
+};
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGCONTROL_H
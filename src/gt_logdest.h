@@ -28,6 +28,7 @@
 #ifndef GT_LOGDEST_H
 #define GT_LOGDEST_H
 
+#include "gt_logging_exports.h"
 #include "gt_logformatter.h"
 #include "gt_loglevel.h"
 
@@ -38,6 +39,15 @@ namespace gt
 namespace log
 {
 
+namespace detail
+{
+
+//! Marks the levels accepted by the destinations as outdated
+GT_LOGGING_EXPORT
+void invalidateAcceptedLevels() noexcept;
+
+} // namespace detail
+
 //! Base class for a logging destination
 class Destination
 {
@@ -51,6 +61,20 @@ public:
 
     //! Returns whether the destination was created correctly
     virtual bool isValid() const { return true; }
+
+    //! Returns whether messages of the given level would be written. Used to
+    //! skip the evaluation of lazy arguments. The logger caches the result,
+    //! thus destinations must call `acceptsChanged` if it changes.
+    virtual bool accepts(Level level) const { (void)level; return true; }
+
+protected:
+
+    //! Notifies the logger, that the levels accepted by the destination
+    //! changed
+    static void acceptsChanged() noexcept
+    {
+        detail::invalidateAcceptedLevels();
+    }
 };
 
 //! Abstract class for a formatted logging destination
@@ -80,11 +104,14 @@ public:
     }
 
     //! Returns whether this level should be logged
-    bool filter(Level level)
+    bool filter(Level level) const
     {
         return m_filter & levelToInt(level);
     }
 
+    //! Returns whether this level passes the filter
+    bool accepts(Level level) const override { return filter(level); }
+
     //! Sets the filter level
     FormattedDestination& filterLevel(Level level, bool include = true)
     {
@@ -96,6 +123,7 @@ public:
         {
             m_filter &= ~levelToInt(level);
         }
+        acceptsChanged();
         return *this;
     }
 
@@ -103,6 +131,7 @@ public:
     FormattedDestination& filterAll(bool include = true)
     {
         m_filter &= include ? -1 : 0;
+        acceptsChanged();
         return *this;
     }
 
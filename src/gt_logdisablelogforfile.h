@@ -8,9 +8,13 @@
 // When included AFTER gt_log.h, this file will disable logging in that C++ file. When included
 // before, it will lead to compiler warnings or errors about macro redefinitions.
 
-#ifndef FORCE_LOGGING
-#define FORCE_LOGGING 1
-#endif
+// strip any remaining logging statement of this file
+#undef GT_LOG_MIN_LEVEL
+#define GT_LOG_MIN_LEVEL gt::log::OffLevel
+
+// the stream is never constructed nor are its arguments evaluated. The
+// statement must still compile, thus the compiler removes it entirely.
+#define GT_LOG_IMPL_DISABLED() if (true) {} else gt::log::Stream()
 
 #undef gtTrace
 #undef gtDebug
@@ -26,17 +30,88 @@
 #undef gtErrorId
 #undef gtFatalId
 
+#undef gtTraceV
+#undef gtDebugV
+#undef gtInfoV
+#undef gtWarningV
+#undef gtErrorV
+#undef gtFatalV
+
+#undef gtTraceIdV
+#undef gtDebugIdV
+#undef gtInfoIdV
+#undef gtWarningIdV
+#undef gtErrorIdV
+#undef gtFatalIdV
+
+#undef gtTraceF
+#undef gtDebugF
+#undef gtInfoF
+#undef gtWarningF
+#undef gtErrorF
+#undef gtFatalF
+
+#undef gtTraceIdF
+#undef gtDebugIdF
+#undef gtInfoIdF
+#undef gtWarningIdF
+#undef gtErrorIdF
+#undef gtFatalIdF
+
+#undef gtTraceB
+#undef gtDebugB
+#undef gtInfoB
+#undef gtWarningB
+#undef gtErrorB
+#undef gtFatalB
+
+#undef gtTraceRt
+#undef gtDebugRt
+#undef gtInfoRt
+#undef gtWarningRt
+#undef gtErrorRt
+#undef gtFatalRt
+
 #undef gtLogOnce
 #undef gtLogOnceId
+#undef gtLogOnceSite
+#undef gtLogOnceSiteId
+
+#undef gtTraceEveryN
+#undef gtDebugEveryN
+#undef gtInfoEveryN
+#undef gtWarningEveryN
+#undef gtErrorEveryN
+#undef gtFatalEveryN
+#undef gtTraceEveryMs
+#undef gtDebugEveryMs
+#undef gtInfoEveryMs
+#undef gtWarningEveryMs
+#undef gtErrorEveryMs
+#undef gtFatalEveryMs
+#undef gtTraceFirstN
+#undef gtDebugFirstN
+#undef gtInfoFirstN
+#undef gtWarningFirstN
+#undef gtErrorFirstN
+#undef gtFatalFirstN
 
-#define gtTrace()    if (!FORCE_LOGGING) {} else gt::log::Stream()
-#define gtDebug()    if (!FORCE_LOGGING) {} else gt::log::Stream()
-#define gtInfo()     if (!FORCE_LOGGING) {} else gt::log::Stream()
-#define gtWarning()  if (!FORCE_LOGGING) {} else gt::log::Stream()
-#define gtError()    if (!FORCE_LOGGING) {} else gt::log::Stream()
-#define gtFatal()    if (!FORCE_LOGGING) {} else gt::log::Stream()
+#undef gtTraceSampled
+#undef gtDebugSampled
+#undef gtInfoSampled
+#undef gtWarningSampled
+#undef gtErrorSampled
+#undef gtFatalSampled
 
-#define gtLogOnce(...)  if (!FORCE_LOGGING) {} else gt::log::Stream()
+#define gtTrace()    GT_LOG_IMPL_DISABLED()
+#define gtDebug()    GT_LOG_IMPL_DISABLED()
+#define gtInfo()     GT_LOG_IMPL_DISABLED()
+#define gtWarning()  GT_LOG_IMPL_DISABLED()
+#define gtError()    GT_LOG_IMPL_DISABLED()
+#define gtFatal()    GT_LOG_IMPL_DISABLED()
+
+#define gtLogOnce(...)  GT_LOG_IMPL_DISABLED()
+#define gtLogOnceSite(LEVEL) GT_LOG_IMPL_DISABLED()
 
 #define gtTraceId(ID)    gtTrace()   .operator<<('[' + std::string{ID} + ']')
 #define gtDebugId(ID)    gtDebug()   .operator<<('[' + std::string{ID} + ']')
@@ -45,5 +120,76 @@
 #define gtErrorId(ID)    gtError()   .operator<<('[' + std::string{ID} + ']')
 #define gtFatalId(ID)    gtFatal()   .operator<<('[' + std::string{ID} + ']')
 #define gtLogOnceId(...) gtLogOnce()
+#define gtLogOnceSiteId(LEVEL, ID) gtLogOnceSite(LEVEL)
+
+#define gtTraceV(V)      GT_LOG_IMPL_DISABLED()
+#define gtDebugV(V)      GT_LOG_IMPL_DISABLED()
+#define gtInfoV(V)       GT_LOG_IMPL_DISABLED()
+#define gtWarningV(V)    GT_LOG_IMPL_DISABLED()
+#define gtErrorV(V)      GT_LOG_IMPL_DISABLED()
+#define gtFatalV(V)      GT_LOG_IMPL_DISABLED()
+
+#define gtTraceIdV(ID, V)   GT_LOG_IMPL_DISABLED()
+#define gtDebugIdV(ID, V)   GT_LOG_IMPL_DISABLED()
+#define gtInfoIdV(ID, V)    GT_LOG_IMPL_DISABLED()
+#define gtWarningIdV(ID, V) GT_LOG_IMPL_DISABLED()
+#define gtErrorIdV(ID, V)   GT_LOG_IMPL_DISABLED()
+#define gtFatalIdV(ID, V)   GT_LOG_IMPL_DISABLED()
+
+#define gtTraceF(...)    GT_LOG_IMPL_DISABLED()
+#define gtDebugF(...)    GT_LOG_IMPL_DISABLED()
+#define gtInfoF(...)     GT_LOG_IMPL_DISABLED()
+#define gtWarningF(...)  GT_LOG_IMPL_DISABLED()
+#define gtErrorF(...)    GT_LOG_IMPL_DISABLED()
+#define gtFatalF(...)    GT_LOG_IMPL_DISABLED()
+
+#define gtTraceIdF(ID, ...)   GT_LOG_IMPL_DISABLED()
+#define gtDebugIdF(ID, ...)   GT_LOG_IMPL_DISABLED()
+#define gtInfoIdF(ID, ...)    GT_LOG_IMPL_DISABLED()
+#define gtWarningIdF(ID, ...) GT_LOG_IMPL_DISABLED()
+#define gtErrorIdF(ID, ...)   GT_LOG_IMPL_DISABLED()
+#define gtFatalIdF(ID, ...)   GT_LOG_IMPL_DISABLED()
+
+#define gtTraceB(...)    GT_LOG_IMPL_DISABLED()
+#define gtDebugB(...)    GT_LOG_IMPL_DISABLED()
+#define gtInfoB(...)     GT_LOG_IMPL_DISABLED()
+#define gtWarningB(...)  GT_LOG_IMPL_DISABLED()
+#define gtErrorB(...)    GT_LOG_IMPL_DISABLED()
+#define gtFatalB(...)    GT_LOG_IMPL_DISABLED()
+
+#define gtTraceRt(...)   GT_LOG_IMPL_DISABLED()
+#define gtDebugRt(...)   GT_LOG_IMPL_DISABLED()
+#define gtInfoRt(...)    GT_LOG_IMPL_DISABLED()
+#define gtWarningRt(...) GT_LOG_IMPL_DISABLED()
+#define gtErrorRt(...)   GT_LOG_IMPL_DISABLED()
+#define gtFatalRt(...)   GT_LOG_IMPL_DISABLED()
+
+#define gtTraceEveryN(N)       GT_LOG_IMPL_DISABLED()
+#define gtDebugEveryN(N)       GT_LOG_IMPL_DISABLED()
+#define gtInfoEveryN(N)        GT_LOG_IMPL_DISABLED()
+#define gtWarningEveryN(N)     GT_LOG_IMPL_DISABLED()
+#define gtErrorEveryN(N)       GT_LOG_IMPL_DISABLED()
+#define gtFatalEveryN(N)       GT_LOG_IMPL_DISABLED()
+
+#define gtTraceEveryMs(MS)     GT_LOG_IMPL_DISABLED()
+#define gtDebugEveryMs(MS)     GT_LOG_IMPL_DISABLED()
+#define gtInfoEveryMs(MS)      GT_LOG_IMPL_DISABLED()
+#define gtWarningEveryMs(MS)   GT_LOG_IMPL_DISABLED()
+#define gtErrorEveryMs(MS)     GT_LOG_IMPL_DISABLED()
+#define gtFatalEveryMs(MS)     GT_LOG_IMPL_DISABLED()
+
+#define gtTraceFirstN(N)       GT_LOG_IMPL_DISABLED()
+#define gtDebugFirstN(N)       GT_LOG_IMPL_DISABLED()
+#define gtInfoFirstN(N)        GT_LOG_IMPL_DISABLED()
+#define gtWarningFirstN(N)     GT_LOG_IMPL_DISABLED()
+#define gtErrorFirstN(N)       GT_LOG_IMPL_DISABLED()
+#define gtFatalFirstN(N)       GT_LOG_IMPL_DISABLED()
+
+#define gtTraceSampled(RATE)   GT_LOG_IMPL_DISABLED()
+#define gtDebugSampled(RATE)   GT_LOG_IMPL_DISABLED()
+#define gtInfoSampled(RATE)    GT_LOG_IMPL_DISABLED()
+#define gtWarningSampled(RATE) GT_LOG_IMPL_DISABLED()
+#define gtErrorSampled(RATE)   GT_LOG_IMPL_DISABLED()
+#define gtFatalSampled(RATE)   GT_LOG_IMPL_DISABLED()
 
 #endif // GT_LOGDISABLELOGFORFILE_H
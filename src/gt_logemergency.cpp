@@ -0,0 +1,298 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logemergency.h"
+#include "gt_logging.h"
+
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+using namespace gt;
+
+using MutexLocker = const std::lock_guard<std::mutex>;
+
+namespace
+{
+
+/// registered descriptors (fd + 1, zero denotes a free entry). Zero
+/// initialized before any code runs, thus safe to use in signal handlers
+std::atomic<int> emergencyFds[log::MaxEmergencyFds];
+
+/// guards the registration of descriptors
+std::mutex&
+emergencyFdMutex()
+{
+    static auto* mutex = new std::mutex;
+    return *mutex;
+}
+
+//! Writes all data to the descriptor, retrying on interrupts
+void
+writeAll(int fd, char const* data, std::size_t size) noexcept
+{
+    while (size > 0)
+    {
+#ifdef _WIN32
+        int n = _write(fd, data, static_cast<unsigned>(size));
+#else
+        ssize_t n = ::write(fd, data, size);
+#endif
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return;
+
+        data += n;
+        size -= static_cast<std::size_t>(n);
+    }
+}
+
+#ifndef _WIN32
+
+/// signals handled by the crash handler
+constexpr int CrashSignals[] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+constexpr std::size_t CrashSignalCount =
+    sizeof(CrashSignals) / sizeof(CrashSignals[0]);
+
+char const*
+signalName(int sig) noexcept
+{
+    switch (sig)
+    {
+    case SIGSEGV: return "SIGSEGV";
+    case SIGABRT: return "SIGABRT";
+    case SIGBUS:  return "SIGBUS";
+    case SIGFPE:  return "SIGFPE";
+    case SIGILL:  return "SIGILL";
+    default:      return "unknown";
+    }
+}
+
+//! State of the crash handler. The signal handler requests a flush from a
+//! helper thread, as flushing is not async-signal-safe, and waits for it
+//! with a timeout (the crashing thread may hold a lock of the logger).
+struct CrashHandler
+{
+    std::mutex mutex;
+    bool installed{false};
+    struct sigaction previous[CrashSignalCount];
+
+    std::atomic<int> flushTimeout{2000};
+    /// pipes to request a flush and to signal its completion
+    int request[2]{-1, -1};
+    int done[2]{-1, -1};
+    /// set by the first crashing thread
+    std::atomic<bool> crashing{false};
+
+    //! Creates the pipes and starts the helper thread (once)
+    bool start()
+    {
+        if (request[0] != -1) return true;
+
+        if (!openPipe(request)) return false;
+        if (!openPipe(done))
+        {
+            ::close(request[0]);
+            ::close(request[1]);
+            request[0] = request[1] = -1;
+            return false;
+        }
+
+        // never joined, waits for a crash until the process exits
+        std::thread([this](){ run(); }).detach();
+        return true;
+    }
+
+    static bool openPipe(int (&fds)[2])
+    {
+        if (::pipe(fds) != 0) return false;
+        for (int fd : fds) ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        return true;
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            char c;
+            ssize_t n = ::read(request[0], &c, 1);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return;
+
+            log::Logger::instance().flush();
+            writeAll(done[1], &c, 1);
+        }
+    }
+
+    std::size_t indexOf(int sig) const
+    {
+        std::size_t i = 0;
+        while (i < CrashSignalCount && CrashSignals[i] != sig) ++i;
+        return i;
+    }
+};
+
+CrashHandler&
+crashHandler()
+{
+    // never destroyed, as signals may be raised during shutdown
+    static auto* handler = new CrashHandler;
+    return *handler;
+}
+
+void
+onCrash(int sig, siginfo_t* info, void* /*context*/)
+{
+    int savedErrno = errno;
+    CrashHandler& h = crashHandler();
+
+    {
+        log::EmergencyStream stream(log::FatalLevel);
+        stream << "caught signal " << sig << " (" << signalName(sig) << ")";
+        if (info && (sig == SIGSEGV || sig == SIGBUS))
+        {
+            stream << " at address " << static_cast<void const*>(info->si_addr);
+        }
+    }
+
+    // only the first crashing thread requests the flush, all wait for it
+    if (!h.crashing.exchange(true))
+    {
+        char c = 0;
+        writeAll(h.request[1], &c, 1);
+    }
+
+    pollfd fd{h.done[0], POLLIN, 0};
+    int timeout = h.flushTimeout.load(std::memory_order_relaxed);
+    while (::poll(&fd, 1, timeout) < 0 && errno == EINTR) {}
+
+    // the signal is delivered to the previous handler (or the default
+    // action) once this handler returns
+    std::size_t index = h.indexOf(sig);
+    if (index < CrashSignalCount)
+    {
+        ::sigaction(sig, &h.previous[index], nullptr);
+    }
+    ::raise(sig);
+
+    errno = savedErrno;
+}
+
+#endif
+
+} // namespace
+
+bool
+log::addEmergencyFd(int fd)
+{
+    if (fd < 0) return false;
+
+    MutexLocker lock(emergencyFdMutex());
+
+    for (auto const& entry : emergencyFds)
+    {
+        if (entry.load(std::memory_order_relaxed) == fd + 1) return false;
+    }
+    for (auto& entry : emergencyFds)
+    {
+        if (entry.load(std::memory_order_relaxed) != 0) continue;
+
+        entry.store(fd + 1, std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+bool
+log::removeEmergencyFd(int fd)
+{
+    MutexLocker lock(emergencyFdMutex());
+
+    for (auto& entry : emergencyFds)
+    {
+        if (entry.load(std::memory_order_relaxed) != fd + 1) continue;
+
+        entry.store(0, std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+void
+log::emergencyWrite(char const* data, std::size_t size) noexcept
+{
+    bool written = false;
+    for (auto const& entry : emergencyFds)
+    {
+        int fd = entry.load(std::memory_order_acquire) - 1;
+        if (fd < 0) continue;
+
+        writeAll(fd, data, size);
+        written = true;
+    }
+
+    if (!written) writeAll(2, data, size);
+}
+
+bool
+log::Logger::installCrashHandler(CrashHandlerOptions const& options)
+{
+#ifdef _WIN32
+    (void)options;
+    std::cerr << "GtLogging: the crash handler is not supported on this "
+                 "platform!\n";
+    return false;
+#else
+    CrashHandler& h = crashHandler();
+    MutexLocker lock(h.mutex);
+
+    h.flushTimeout = options.flushTimeout;
+    if (h.installed) return true;
+
+    if (!h.start())
+    {
+        std::cerr << "GtLogging: failed to start the crash handler!\n";
+        return false;
+    }
+
+    struct sigaction action{};
+    action.sa_sigaction = onCrash;
+    action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+
+    for (std::size_t i = 0; i < CrashSignalCount; ++i)
+    {
+        ::sigaction(CrashSignals[i], &action, &h.previous[i]);
+    }
+
+    h.installed = true;
+    return true;
+#endif
+}
+
+void
+log::Logger::removeCrashHandler()
+{
+#ifndef _WIN32
+    CrashHandler& h = crashHandler();
+    MutexLocker lock(h.mutex);
+
+    if (!h.installed) return;
+
+    for (std::size_t i = 0; i < CrashSignalCount; ++i)
+    {
+        ::sigaction(CrashSignals[i], &h.previous[i], nullptr);
+    }
+    h.installed = false;
+#endif
+}
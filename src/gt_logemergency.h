@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGEMERGENCY_H
+#define GT_LOGEMERGENCY_H
+
+#include "gt_logging_exports.h"
+#include "gt_loglevel.h"
+#include "gt_logstream.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace gt
+{
+
+namespace log
+{
+
+/// Maximum number of file descriptors for emergency messages
+constexpr std::size_t MaxEmergencyFds = 8;
+
+//! Options of the crash handler
+struct CrashHandlerOptions
+{
+    /// Maximum time in milliseconds to wait for pending messages to be
+    /// written before the process terminates
+    int flushTimeout = 2000;
+};
+
+//! Registers a file descriptor that emergency messages are written to (e.g.
+//! of a crash log opened at startup). Returns false if the descriptor is
+//! already registered or no more descriptors can be registered. If no
+//! descriptor is registered, emergency messages are written to stderr.
+GT_LOGGING_EXPORT
+bool addEmergencyFd(int fd);
+
+//! Unregisters a file descriptor. Does not close it.
+GT_LOGGING_EXPORT
+bool removeEmergencyFd(int fd);
+
+//! Writes the data to all registered file descriptors using `write(2)`.
+//! Async-signal-safe, bypasses the logger and its destinations.
+GT_LOGGING_EXPORT
+void emergencyWrite(char const* data, std::size_t size) noexcept;
+
+/**
+ * @brief Async-signal-safe stream for emergency messages (e.g. in crash
+ * handlers). The message is formatted into a buffer on the stack, using
+ * signal-safe primitives only, and written to the emergency file descriptors
+ * once the stream is destroyed. The logging level does not apply. Messages
+ * exceeding the buffer are truncated.
+ *
+ * gt::log::EmergencyStream(gt::log::FatalLevel) << "caught signal " << sig;
+ */
+class EmergencyStream
+{
+public:
+
+    /// Size of the buffer including the trailing new line
+    static constexpr std::size_t Capacity = 512;
+
+    explicit EmergencyStream(Level level = FatalLevel) noexcept
+    {
+        *this << levelToText(level) << " [emergency] ";
+    }
+
+    ~EmergencyStream() { flush(); }
+
+    EmergencyStream(EmergencyStream const&) = delete;
+    EmergencyStream& operator=(EmergencyStream const&) = delete;
+
+    EmergencyStream& operator<<(char const* text) noexcept
+    {
+        if (!text) text = "(null)";
+        while (*text) *this << *text++;
+        return *this;
+    }
+
+    EmergencyStream& operator<<(char c) noexcept
+    {
+        // keep one character for the new line
+        if (m_size < Capacity - 1) m_buffer[m_size++] = c;
+        return *this;
+    }
+
+    EmergencyStream& operator<<(bool b) noexcept
+    {
+        return *this << (b ? "true" : "false");
+    }
+
+    template <typename T,
+              std::enable_if_t<std::is_integral<T>::value &&
+                               !std::is_same<T, bool>::value &&
+                               !std::is_same<T, char>::value, bool> = true>
+    EmergencyStream& operator<<(T value) noexcept
+    {
+        using U = std::make_unsigned_t<T>;
+        U magnitude = static_cast<U>(value);
+        if (value < 0)
+        {
+            *this << '-';
+            magnitude = static_cast<U>(0) - magnitude;
+        }
+
+        char digits[20];
+        int length = detail::appendDigits(digits, magnitude);
+        for (int i = 0; i < length; ++i) *this << digits[i];
+        return *this;
+    }
+
+    EmergencyStream& operator<<(void const* p) noexcept
+    {
+        static constexpr char hexDigits[] = "0123456789abcdef";
+
+        char digits[2 * sizeof(void*)];
+        int length = 0;
+        auto value = reinterpret_cast<std::uintptr_t>(p);
+        do
+        {
+            digits[length++] = hexDigits[value & 0xf];
+            value >>= 4;
+        }
+        while (value);
+
+        *this << "0x";
+        while (length) *this << digits[--length];
+        return *this;
+    }
+
+    //! Writes the message (if any) to the emergency file descriptors
+    void flush() noexcept
+    {
+        if (m_size == 0) return;
+
+        m_buffer[m_size++] = '\n';
+        emergencyWrite(m_buffer, m_size);
+        m_size = 0;
+    }
+
+private:
+
+    char m_buffer[Capacity];
+    std::size_t m_size = 0;
+};
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGEMERGENCY_H
@@ -0,0 +1,29 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logfield.h"
+
+using namespace gt;
+
+std::string
+log::Field::valueToString() const
+{
+    switch (type)
+    {
+    case Bool:
+        return number.b ? "true" : "false";
+    case Int:
+        return std::to_string(number.i);
+    case UInt:
+        return std::to_string(number.u);
+    case Double:
+    {
+        Stream stream;
+        stream.nospace().roundtrip() << number.d;
+        return stream.message();
+    }
+    case String:
+    default:
+        return text;
+    }
+}
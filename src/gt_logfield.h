@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGFIELD_H
+#define GT_LOGFIELD_H
+
+#include "gt_loglevel.h"
+#include "gt_logstream.h"
+
+#include <string>
+#include <type_traits>
+
+namespace gt
+{
+
+namespace log
+{
+
+namespace detail
+{
+
+//! Type of the field storing values of type T
+template <typename T>
+using FieldType = std::integral_constant<Field::Type,
+    std::is_same<T, bool>::value ? Field::Bool :
+    std::is_floating_point<T>::value ? Field::Double :
+    std::is_integral<T>::value && !std::is_same<T, char>::value ?
+        (std::is_signed<T>::value ? Field::Int : Field::UInt) :
+    Field::String>;
+
+template <typename T>
+inline void setFieldValue(Field& f, T value,
+                          std::integral_constant<Field::Type, Field::Bool>)
+{
+    f.number.b = value;
+}
+
+template <typename T>
+inline void setFieldValue(Field& f, T value,
+                          std::integral_constant<Field::Type, Field::Int>)
+{
+    f.number.i = static_cast<std::int64_t>(value);
+}
+
+template <typename T>
+inline void setFieldValue(Field& f, T value,
+                          std::integral_constant<Field::Type, Field::UInt>)
+{
+    f.number.u = static_cast<std::uint64_t>(value);
+}
+
+template <typename T>
+inline void setFieldValue(Field& f, T value,
+                          std::integral_constant<Field::Type, Field::Double>)
+{
+    f.number.d = static_cast<double>(value);
+}
+
+//! Other types are formatted using their stream operators
+template <typename T>
+inline void setFieldValue(Field& f, T const& value,
+                          std::integral_constant<Field::Type, Field::String>)
+{
+    Stream stream;
+    stream.nospace() << value;
+    f.text = stream.message();
+}
+
+inline void setFieldValue(Field& f, std::string const& value,
+                          std::integral_constant<Field::Type, Field::String>)
+{
+    f.text = value;
+}
+
+} // namespace detail
+
+/**
+ * @brief Creates a structured field, which is attached to the message
+ * instead of being formatted into its text. Booleans, integers and floating
+ * point values keep their type, other values are stored as text using their
+ * stream operators.
+ *
+ * gtInfo() << "converged" << gt::log::field("iter", n)
+ *                         << gt::log::field("residual", r);
+ *
+ * Text formatters append the fields to the message ("converged iter=12
+ * residual=1e-08"), destinations may access them in `Details::fields`.
+ * @param key Key of the field
+ * @param value Value of the field
+ * @return Field
+ */
+template <typename T>
+inline Field
+field(std::string key, T const& value)
+{
+    using Type = detail::FieldType<T>;
+
+    Field f;
+    f.key = std::move(key);
+    f.type = Type::value;
+    detail::setFieldValue(f, value, Type{});
+    return f;
+}
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGFIELD_H
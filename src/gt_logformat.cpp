@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logformat.h"
+
+#include <cassert>
+#include <cstring>
+
+using namespace gt;
+
+namespace
+{
+
+//! Applies the format specification to the stream
+void applySpec(log::Stream& s, log::detail::FormatSpec const& spec)
+{
+    using ios = std::ios_base;
+
+    ios::fmtflags flags = ios::dec;
+    switch (spec.type)
+    {
+    case 'x': flags = ios::hex; break;
+    case 'X': flags = ios::hex | ios::uppercase; break;
+    case 'o': flags = ios::oct; break;
+    case 'e': flags |= ios::scientific; break;
+    case 'E': flags |= ios::scientific | ios::uppercase; break;
+    case 'f': flags |= ios::fixed; break;
+    case 'F': flags |= ios::fixed | ios::uppercase; break;
+    case 'G': flags |= ios::uppercase; break;
+    default: break;
+    }
+
+    if (spec.plus) flags |= ios::showpos;
+    // only one of them applies to the type of the argument
+    if (spec.alternate) flags |= ios::showbase | ios::showpoint;
+
+    char fill = spec.fill;
+    switch (spec.align)
+    {
+    case '<': flags |= ios::left; break;
+    case '>': flags |= ios::right; break;
+    default:
+        // zeros are inserted between sign or prefix and digits
+        if (spec.zero)
+        {
+            flags |= ios::internal;
+            fill = '0';
+        }
+        break;
+    }
+
+    s.setf(flags, ios::basefield | ios::floatfield | ios::adjustfield |
+                  ios::showpos | ios::showbase | ios::showpoint |
+                  ios::uppercase);
+    s.width(spec.width);
+    s.fill(fill);
+    if (spec.precision >= 0)
+    {
+        s.precision(spec.precision);
+        s.noroundtrip();
+    }
+}
+
+} // namespace
+
+log::Stream&
+log::detail::formatMessage(Stream& s,
+                           char const* fmt,
+                           FormatArg const* args,
+                           std::size_t count)
+{
+    if (!s.mayLog()) return s;
+
+    { // block for state saver
+        StreamStateSaver saver{s};
+        s.nospace();
+
+        std::size_t arg = 0;
+        while (char const* brace = std::strpbrk(fmt, "{}"))
+        {
+            s.append(fmt, brace - fmt);
+
+            // escaped brace
+            if (*brace == '}' || brace[1] == '{')
+            {
+                s.append(brace, 1);
+                fmt = brace + 2;
+                continue;
+            }
+
+            FormatSpec spec{};
+            char const* end = parseFormatSpec(brace + 1, spec);
+            // the format string was validated at compile time
+            assert(end && arg < count);
+            if (!end || arg >= count) return s;
+
+            FormatArg const& a = args[arg++];
+            if (end == brace + 1)
+            {
+                a.write(s, a.value);
+            }
+            else
+            {
+                StreamStateSaver argSaver{s};
+                applySpec(s, spec);
+                a.write(s, a.value);
+            }
+            fmt = end + 1;
+        }
+        s.append(fmt, std::strlen(fmt));
+    }
+
+    return s.doLogSpace();
+}
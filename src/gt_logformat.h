@@ -0,0 +1,315 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGFORMAT_H
+#define GT_LOGFORMAT_H
+
+#include "gt_logging_exports.h"
+#include "gt_logstream.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+// format strings are validated in a constant expression. Compilers that
+// support C++20 are forced to do so by using consteval.
+#if defined(__cpp_consteval)
+#define GT_LOG_CONSTEVAL consteval
+#else
+#define GT_LOG_CONSTEVAL constexpr
+#endif
+
+namespace gt
+{
+
+namespace log
+{
+
+namespace detail
+{
+
+//! Result of the validation of a format string
+enum FormatError
+{
+    FormatOk = 0,
+    FormatMissingArguments,
+    FormatTooManyArguments,
+    FormatUnmatchedBrace,
+    FormatInvalidSpec,
+    FormatTypeMismatch
+};
+
+//! Category of an argument, used to check the format specification
+enum FormatArgKind
+{
+    FormatArgInteger = 0,
+    FormatArgFloat,
+    FormatArgBool,
+    FormatArgChar,
+    FormatArgString,
+    FormatArgOther
+};
+
+//! Format specification of a single replacement field:
+//! `{:[[fill]align][+][#][0][width][.precision][type]}`
+struct FormatSpec
+{
+    /// fill character
+    char fill = ' ';
+    /// alignment ('<' or '>'), 0 if not set
+    char align = 0;
+    /// presentation type (d, x, X, o, e, E, f, F, g, G, s), 0 if not set
+    char type = 0;
+    /// whether a sign is written for positive numbers
+    bool plus = false;
+    /// whether the alternate form is used (prefix or decimal point)
+    bool alternate = false;
+    /// whether numbers are padded with zeros
+    bool zero = false;
+    /// field width
+    int width = 0;
+    /// precision of floating point values, -1 if not set
+    int precision = -1;
+};
+
+template <typename... Ts>
+struct FormatTypeList {};
+
+template <typename T>
+struct IsFormatString : std::false_type {};
+
+template <typename... Ts>
+struct IsFormatString<std::basic_string<char, Ts...>> : std::true_type {};
+
+template <>
+struct IsFormatString<char*> : std::true_type {};
+
+template <>
+struct IsFormatString<char const*> : std::true_type {};
+
+template <typename T>
+constexpr FormatArgKind formatArgKind()
+{
+    using U = std::decay_t<T>;
+    return std::is_same<U, bool>::value ? FormatArgBool :
+           std::is_same<U, char>::value ? FormatArgChar :
+           std::is_integral<U>::value ? FormatArgInteger :
+           std::is_floating_point<U>::value ? FormatArgFloat :
+           IsFormatString<U>::value ? FormatArgString : FormatArgOther;
+}
+
+constexpr bool isFormatDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+constexpr bool isFormatAlign(char c)
+{
+    return c == '<' || c == '>';
+}
+
+constexpr bool isFormatType(char c)
+{
+    return c == 'd' || c == 'x' || c == 'X' || c == 'o' ||
+           c == 'e' || c == 'E' || c == 'f' || c == 'F' ||
+           c == 'g' || c == 'G' || c == 's';
+}
+
+/**
+ * @brief Parses the replacement field starting after the opening brace.
+ * @param s Format string after '{'
+ * @param spec Format specification to fill
+ * @return Pointer to the closing brace or nullptr if the field is invalid
+ */
+constexpr char const* parseFormatSpec(char const* s, FormatSpec& spec)
+{
+    if (*s == '}') return s;
+    if (*s++ != ':') return nullptr;
+
+    if (*s && *s != '{' && *s != '}' && isFormatAlign(s[1]))
+    {
+        spec.fill = s[0];
+        spec.align = s[1];
+        s += 2;
+    }
+    else if (isFormatAlign(*s))
+    {
+        spec.align = *s++;
+    }
+
+    if (*s == '+') { spec.plus = true; ++s; }
+    if (*s == '#') { spec.alternate = true; ++s; }
+    if (*s == '0') { spec.zero = true; ++s; }
+
+    for (; isFormatDigit(*s); ++s)
+    {
+        spec.width = spec.width * 10 + (*s - '0');
+        if (spec.width > 1024) return nullptr;
+    }
+
+    if (*s == '.')
+    {
+        if (!isFormatDigit(*++s)) return nullptr;
+        spec.precision = 0;
+        for (; isFormatDigit(*s); ++s)
+        {
+            spec.precision = spec.precision * 10 + (*s - '0');
+            if (spec.precision > 1024) return nullptr;
+        }
+    }
+
+    if (isFormatType(*s)) spec.type = *s++;
+
+    return *s == '}' ? s : nullptr;
+}
+
+//! Returns whether the format specification can be applied to the argument
+constexpr bool isFormatSpecValid(FormatSpec const& spec, FormatArgKind kind)
+{
+    bool isNumber = kind == FormatArgInteger || kind == FormatArgFloat;
+    switch (spec.type)
+    {
+    case 'd': case 'x': case 'X': case 'o':
+        if (kind != FormatArgInteger) return false;
+        break;
+    case 'e': case 'E': case 'f': case 'F': case 'g': case 'G':
+        if (kind != FormatArgFloat) return false;
+        break;
+    case 's':
+        if (isNumber) return false;
+        break;
+    default:
+        break;
+    }
+
+    if (spec.precision >= 0 && kind != FormatArgFloat) return false;
+    if ((spec.plus || spec.alternate || spec.zero) && !isNumber) return false;
+    return true;
+}
+
+/**
+ * @brief Validates the format string against the types of the arguments.
+ * Replacement fields are denoted by `{}` or `{:spec}`, literal braces must
+ * be escaped as `{{` and `}}`.
+ * @param fmt Format string
+ * @return Error code
+ */
+template <typename... Ts>
+GT_LOG_CONSTEVAL FormatError validateFormat(char const* fmt,
+                                            FormatTypeList<Ts...>)
+{
+    // the last entry is a dummy for empty argument lists
+    constexpr FormatArgKind kinds[] = { formatArgKind<Ts>()..., FormatArgOther };
+    constexpr std::size_t count = sizeof...(Ts);
+
+    std::size_t arg = 0;
+    while (*fmt)
+    {
+        if (*fmt == '{')
+        {
+            if (fmt[1] == '{')
+            {
+                fmt += 2;
+                continue;
+            }
+
+            FormatSpec spec{};
+            fmt = parseFormatSpec(fmt + 1, spec);
+            if (!fmt) return FormatInvalidSpec;
+            if (arg >= count) return FormatMissingArguments;
+            if (!isFormatSpecValid(spec, kinds[arg])) return FormatTypeMismatch;
+            ++arg;
+        }
+        else if (*fmt == '}' && *++fmt != '}')
+        {
+            return FormatUnmatchedBrace;
+        }
+        ++fmt;
+    }
+
+    return arg == count ? FormatOk : FormatTooManyArguments;
+}
+
+//! Reports errors of the format string at compile time
+template <FormatError Error>
+struct FormatCheck
+{
+    static_assert(Error != FormatMissingArguments,
+                  "gtLogging: format string has more replacement fields "
+                  "than arguments");
+    static_assert(Error != FormatTooManyArguments,
+                  "gtLogging: format string has fewer replacement fields "
+                  "than arguments");
+    static_assert(Error != FormatUnmatchedBrace,
+                  "gtLogging: unmatched '}' in format string, use '}}' to "
+                  "write a brace");
+    static_assert(Error != FormatInvalidSpec,
+                  "gtLogging: invalid or unterminated replacement field in "
+                  "format string");
+    static_assert(Error != FormatTypeMismatch,
+                  "gtLogging: format specification does not match the type "
+                  "of the argument");
+};
+
+//! Type erased argument of a format string
+struct FormatArg
+{
+    void const* value;
+    void(*write)(Stream&, void const*);
+};
+
+template <typename T>
+void writeFormatArg(Stream& s, void const* value)
+{
+    s << *static_cast<T const*>(value);
+}
+
+/**
+ * @brief Writes the format string into the stream. Literal text is appended
+ * directly, arguments are written using the stream operators.
+ * The format string must have been validated.
+ * @param s Stream
+ * @param fmt Format string
+ * @param args Arguments
+ * @param count Number of arguments
+ * @return Stream
+ */
+GT_LOGGING_EXPORT
+Stream& formatMessage(Stream& s, char const* fmt, FormatArg const* args,
+               std::size_t count);
+
+/**
+ * @brief Writes the validated format string using the arguments.
+ * @param s Stream
+ * @param f Holds the format string as a constant expression
+ * (`static constexpr char const* value()`)
+ * @param fmt Format string
+ * @param args Arguments
+ * @return Stream
+ */
+template <typename Fmt, std::size_t N, typename... Args>
+inline Stream& formatMessage(Stream& s, Fmt f, char const(&fmt)[N],
+                             Args const&... args)
+{
+    (void)FormatCheck<validateFormat(Fmt::value(),
+                                     FormatTypeList<Args...>{})>{};
+    (void)f;
+
+    if (!s.mayLog()) return s;
+
+    // the last entry is a dummy for empty argument lists
+    FormatArg const list[] = {
+        FormatArg{std::addressof(args), &writeFormatArg<Args>}...,
+        FormatArg{nullptr, nullptr}
+    };
+    return formatMessage(s, fmt, list, sizeof...(Args));
+}
+
+} // namespace detail
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGFORMAT_H
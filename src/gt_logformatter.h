@@ -11,6 +11,7 @@
 #include <iomanip>
 #include <sstream>
 #include <cassert>
+#include <cmath>
 
 namespace gt
 {
@@ -45,6 +46,50 @@ namespace detail
 inline std::string const& toString(std::string const& s) { return s; }
 inline std::string toString(Level level) { return levelToString(level); }
 inline std::string toString(std::tm time) { return formatTime(time); }
+inline std::string toString(int value) { return std::to_string(value); }
+inline std::string toString(std::uint64_t value) { return std::to_string(value); }
+inline std::string toString(char const* s) { return s; }
+inline std::string toString(Context const& context) { return context.toString(); }
+
+//! Message followed by the fields of the record
+struct MessageWithFields
+{
+    std::string const& message;
+    std::vector<Field> const& fields;
+};
+
+//! Appends the fields as space separated "key=value" pairs. Strings that are
+//! empty or contain spaces, quotes or '=' are quoted.
+inline std::string
+toString(MessageWithFields const& m)
+{
+    std::string out = m.message;
+    for (Field const& f : m.fields)
+    {
+        if (!out.empty() && out.back() != ' ') out += ' ';
+        out += f.key;
+        out += '=';
+
+        std::string value = f.valueToString();
+        bool quote = f.type == Field::String &&
+                     (value.empty() ||
+                      value.find_first_of(" \t\n\"=") != std::string::npos);
+        if (!quote)
+        {
+            out += value;
+            continue;
+        }
+
+        out += '"';
+        for (char c : value)
+        {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        out += '"';
+    }
+    return out;
+}
 
 //! No more args to format
 template <typename Iter>
@@ -87,6 +132,51 @@ formatImpl(size_t idx, Iter begin, Iter end, Arg const& arg, Args const&... args
     return formatImpl(idx + 1, begin, end, args...);
 }
 
+//! Appends the string as a quoted and escaped JSON string
+inline void
+appendJsonString(std::string& out, char const* s, size_t size)
+{
+    static constexpr char hexDigits[] = "0123456789abcdef";
+
+    out += '"';
+    for (size_t i = 0; i < size; ++i)
+    {
+        char c = s[i];
+        switch (c)
+        {
+        case '"':  out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                out += "\\u00";
+                out += hexDigits[(c >> 4) & 0xf];
+                out += hexDigits[c & 0xf];
+            }
+            else
+            {
+                out += c;
+            }
+        }
+    }
+    out += '"';
+}
+
+inline void
+appendJsonString(std::string& out, char const* s)
+{
+    appendJsonString(out, s, std::char_traits<char>::length(s));
+}
+
+inline void
+appendJsonString(std::string& out, std::string const& s)
+{
+    appendJsonString(out, s.data(), s.size());
+}
+
 } // namespace detail
 
 /**
@@ -134,6 +224,28 @@ public:
         operator()(std::string const& msg, Level lvl, Details const& dts) const noexcept;
     };
 
+    /// Formats the message using a pattern (see `gt::log::format`), where %1
+    /// denotes the level, %2 the time, %3 the id, %4 the source file, %5 the
+    /// line, %6 the function, %7 the message (followed by its fields), %8 the
+    /// thread id and %9 the thread name. Example: "%1 [%2] [%8] %4:%5 %7"
+    struct Pattern
+    {
+        std::string pattern;
+
+        std::string
+        operator()(std::string const& msg, Level lvl, Details const& dts) const noexcept;
+    };
+
+    /// Formats the message as a single line JSON object. The id, the location
+    /// and the thread are omitted if they are unknown. The diagnostic context
+    /// and the fields are written as nested objects, if they are not empty.
+    /// Fields keep their type.
+    struct Json
+    {
+        std::string
+        operator()(std::string const& msg, Level lvl, Details const& dts) const noexcept;
+    };
+
     //! Default ctor
     Formatter() = default;
 
@@ -179,24 +291,137 @@ Formatter::Default::operator()(std::string const& msg,
                                Level lvl,
                                Details const& dts) const noexcept
 {
+    detail::MessageWithFields message{msg, dts.fields};
+
     // skip id if its empty
     if (dts.id.empty())
     {
-        return gt::log::format("%1 [%2] %3", lvl, dts.time, msg);
+        return gt::log::format("%1 [%2] %3", lvl, dts.time, message);
     }
 
-    return gt::log::format("%1 [%2] [%3] %4", lvl, dts.time, dts.id, msg);
+    return gt::log::format("%1 [%2] [%3] %4", lvl, dts.time, dts.id, message);
 }
 
 inline std::string
-Formatter::MessageOnly::operator()(const std::string& msg, Level lvl, const Details&) const noexcept
+Formatter::MessageOnly::operator()(const std::string& msg, Level lvl, const Details& dts) const noexcept
 {
+    detail::MessageWithFields message{msg, dts.fields};
+
     if (lvl <= gt::log::InfoLevel)
     {
-        return msg;
+        return detail::toString(message);
+    }
+
+    return gt::log::format("%1: %2", lvl, message);
+}
+
+inline std::string
+Formatter::Pattern::operator()(std::string const& msg,
+                               Level lvl,
+                               Details const& dts) const noexcept
+{
+    return gt::log::format(pattern, lvl, dts.time, dts.id,
+                           dts.location.file, dts.location.line,
+                           dts.location.function,
+                           detail::MessageWithFields{msg, dts.fields},
+                           dts.thread.id, dts.thread.name);
+}
+
+inline std::string
+Formatter::Json::operator()(std::string const& msg,
+                            Level lvl,
+                            Details const& dts) const noexcept
+{
+    // level names are padded
+    std::string level = levelToString(lvl);
+    level.erase(level.find_last_not_of(' ') + 1);
+
+    std::string out = "{\"time\":\"";
+    out += formatTime(dts.time, "%Y-%m-%dT%H:%M:%S");
+    out += "\",\"level\":";
+    detail::appendJsonString(out, level);
+
+    if (!dts.id.empty())
+    {
+        out += ",\"id\":";
+        detail::appendJsonString(out, dts.id);
+    }
+
+    SourceLocation const& location = dts.location;
+    if (location.line > 0)
+    {
+        out += ",\"file\":";
+        detail::appendJsonString(out, location.file);
+        out += ",\"line\":";
+        out += std::to_string(location.line);
+    }
+    if (*location.function)
+    {
+        out += ",\"function\":";
+        detail::appendJsonString(out, location.function);
+    }
+
+    if (dts.thread.id != 0)
+    {
+        out += ",\"thread\":";
+        out += std::to_string(dts.thread.id);
+    }
+    if (*dts.thread.name)
+    {
+        out += ",\"threadName\":";
+        detail::appendJsonString(out, dts.thread.name);
+    }
+
+    if (!dts.context.empty())
+    {
+        char separator = '{';
+        out += ",\"context\":";
+        dts.context.forEach([&](std::string const& key,
+                                std::string const& value){
+            out += separator;
+            detail::appendJsonString(out, key);
+            out += ':';
+            detail::appendJsonString(out, value);
+            separator = ',';
+        });
+        out += '}';
+    }
+
+    if (!dts.fields.empty())
+    {
+        char separator = '{';
+        out += ",\"fields\":";
+        for (Field const& f : dts.fields)
+        {
+            out += separator;
+            detail::appendJsonString(out, f.key);
+            out += ':';
+            separator = ',';
+
+            switch (f.type)
+            {
+            case Field::Bool:
+            case Field::Int:
+            case Field::UInt:
+                out += f.valueToString();
+                break;
+            case Field::Double:
+                // infinity and NaN are not valid JSON numbers
+                if (std::isfinite(f.number.d)) out += f.valueToString();
+                else detail::appendJsonString(out, f.valueToString());
+                break;
+            case Field::String:
+            default:
+                detail::appendJsonString(out, f.text);
+            }
+        }
+        out += '}';
     }
 
-    return gt::log::format("%1: %2", lvl, msg);
+    out += ",\"message\":";
+    detail::appendJsonString(out, msg);
+    out += '}';
+    return out;
 }
 
 } // end namespace log
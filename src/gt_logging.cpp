@@ -26,12 +26,18 @@
 // OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "gt_logging.h"
+#include "gt_logqueue.h"
 
 #include <iostream>
 #include <chrono>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
 #include <vector>
 #include <algorithm>
+#include <list>
+#include <unordered_map>
 
 using MutexLocker = const std::lock_guard<std::mutex>;
 
@@ -42,44 +48,207 @@ namespace log
 
 hash_t hash(std::string const& msg, std::string const& id, Level level)
 {
-    std::hash<std::string> hasher;
-    return hasher(msg + id + std::to_string(level));
+    detail::Hasher hasher;
+    hasher.update(msg);
+    hasher.update(id);
+    hasher.update(static_cast<std::uint64_t>(level));
+    return static_cast<hash_t>(hasher.digest());
+}
+
+namespace
+{
+
+/// set if the levels accepted by the destinations must be determined again
+std::atomic<bool> acceptedLevelsOutdated{false};
+
+} // namespace
+
+void
+detail::invalidateAcceptedLevels() noexcept
+{
+    acceptedLevelsOutdated.store(true, std::memory_order_release);
 }
 
 struct Logger::DefaultCache::Impl
 {
-    Impl()
+    using Clock = std::chrono::steady_clock;
+
+    /// number of independently locked shards
+    static constexpr unsigned ShardBits = 4;
+    static constexpr std::size_t ShardCount = std::size_t{1} << ShardBits;
+
+    struct Entry
     {
-        cache.reserve(128);
-    }
+        hash_t hash;
+        /// time of insertion (only set if the time to live is enabled,
+        /// otherwise set when it is enabled)
+        Clock::time_point time;
+    };
 
-    std::mutex mutex;
-    std::vector<hash_t> cache;
+    //! Hashes of a shard, ordered from the most to the least recently used
+    struct Shard
+    {
+        std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<hash_t, std::list<Entry>::iterator> index;
+        /// maximum number of entries, 0 denotes no limit
+        std::size_t capacity{0};
+        std::chrono::milliseconds timeToLive{0};
+
+        //! Returns whether the entry has expired. Shard must be locked
+        bool isExpired(Entry const& entry, Clock::time_point now) const
+        {
+            return timeToLive.count() > 0 && now - entry.time >= timeToLive;
+        }
+
+        //! Looks up the hash and marks it as recently used if the capacity
+        //! is limited. Removes expired entries. Shard must be locked
+        bool find(hash_t hash, Clock::time_point now)
+        {
+            auto iter = index.find(hash);
+            if (iter == index.end()) return false;
+
+            if (isExpired(*iter->second, now))
+            {
+                entries.erase(iter->second);
+                index.erase(iter);
+                return false;
+            }
+
+            if (capacity > 0)
+            {
+                entries.splice(entries.begin(), entries, iter->second);
+            }
+            return true;
+        }
+
+        //! Inserts a new hash and evicts the least recently used entries
+        //! exceeding the capacity. Shard must be locked
+        void insert(hash_t hash, Clock::time_point now)
+        {
+            entries.push_front({hash, now});
+            index.emplace(hash, entries.begin());
+            trim(now);
+        }
+
+        //! Evicts expired and excess entries. Shard must be locked
+        void trim(Clock::time_point now)
+        {
+            while (!entries.empty() &&
+                   ((capacity > 0 && entries.size() > capacity) ||
+                    isExpired(entries.back(), now)))
+            {
+                index.erase(entries.back().hash);
+                entries.pop_back();
+            }
+        }
+
+        void setOptions(LogOnceCacheOptions const& options)
+        {
+            capacity = options.capacity == 0 ? 0 :
+                (options.capacity + ShardCount - 1) / ShardCount;
+            timeToLive = options.timeToLive;
+
+            // entries inserted without a time to live expire starting now
+            Clock::time_point t = now();
+            for (Entry& entry : entries)
+            {
+                if (entry.time == Clock::time_point{}) entry.time = t;
+            }
+            trim(t);
+        }
+
+        //! Returns the current time if the time to live is enabled, as the
+        //! clock is not queried otherwise
+        Clock::time_point now() const
+        {
+            return timeToLive.count() > 0 ? Clock::now() : Clock::time_point{};
+        }
+    };
+
+    Shard shards[ShardCount];
+
+    //! Returns the shard of the hash. The hash is mixed, as custom hashes
+    //! may not be distributed evenly
+    Shard& shard(hash_t hash)
+    {
+        std::uint64_t h = static_cast<std::uint64_t>(hash);
+        h = (h ^ (h >> 32)) * 0x9e3779b97f4a7c15ull;
+        return shards[h >> (64 - ShardBits)];
+    }
 };
 
+constexpr unsigned Logger::DefaultCache::Impl::ShardBits;
+constexpr std::size_t Logger::DefaultCache::Impl::ShardCount;
+
 Logger::DefaultCache::DefaultCache() : pimpl(std::make_unique<Impl>()) { }
 
+Logger::DefaultCache::DefaultCache(LogOnceCacheOptions const& options) :
+    DefaultCache()
+{
+    setOptions(options);
+}
+
 Logger::DefaultCache::~DefaultCache() = default;
 
 void
 Logger::DefaultCache::append(hash_t hash)
 {
-    MutexLocker locker(pimpl->mutex);
-    pimpl->cache.push_back(hash);
+    insert(hash);
+}
+
+bool
+Logger::DefaultCache::insert(hash_t hash)
+{
+    Impl::Shard& shard = pimpl->shard(hash);
+    MutexLocker locker(shard.mutex);
+
+    auto now = shard.now();
+    if (shard.find(hash, now)) return false;
+
+    shard.insert(hash, now);
+    return true;
 }
 
 void
 Logger::DefaultCache::clear()
 {
-    MutexLocker locker(pimpl->mutex);
-    pimpl->cache.clear();
+    for (Impl::Shard& shard : pimpl->shards)
+    {
+        MutexLocker locker(shard.mutex);
+        shard.entries.clear();
+        shard.index.clear();
+    }
 }
 
 bool
 Logger::DefaultCache::find(hash_t hash) const noexcept
 {
-    MutexLocker locker(pimpl->mutex);
-    return std::find(pimpl->cache.begin(), pimpl->cache.end(), hash) != pimpl->cache.end();
+    Impl::Shard& shard = pimpl->shard(hash);
+    MutexLocker locker(shard.mutex);
+    return shard.find(hash, shard.now());
+}
+
+size_t
+Logger::DefaultCache::size() const
+{
+    size_t n = 0;
+    for (Impl::Shard& shard : pimpl->shards)
+    {
+        MutexLocker locker(shard.mutex);
+        n += shard.entries.size();
+    }
+    return n;
+}
+
+void
+Logger::DefaultCache::setOptions(LogOnceCacheOptions const& options)
+{
+    for (Impl::Shard& shard : pimpl->shards)
+    {
+        MutexLocker locker(shard.mutex);
+        shard.setOptions(options);
+    }
 }
 
 struct DestinationEntry
@@ -88,6 +257,642 @@ struct DestinationEntry
     DestinationPtr ptr;
 };
 
+namespace
+{
+
+std::tm
+localTime(std::time_t rawtime)
+{
+    std::tm timebuf;
+
+// https://en.cppreference.com/w/c/chrono/localtime
+#ifdef _WIN32
+    localtime_s(&timebuf, &rawtime);
+#else
+    localtime_r(&rawtime, &timebuf);
+#endif
+
+    return timebuf;
+}
+
+//! Queued log message of the asynchronous logging mode
+struct Record
+{
+    Level level{InfoLevel};
+    std::string message;
+    std::string id;
+    std::time_t time{};
+    /// format id of a binary record (message holds the encoded arguments)
+    std::uint32_t format{0};
+    /// location of the logging statement
+    SourceLocation location{};
+    /// thread of the logging statement
+    ThreadInfo thread{};
+    /// diagnostic context of the thread
+    Context context{};
+    /// structured fields of the message
+    std::vector<Field> fields;
+};
+
+//! Backend of the asynchronous logging mode. Producers push records into the
+//! lock-free queue, the backend thread drains it into the destinations.
+class AsyncBackend
+{
+public:
+
+    using WriteFunction = std::function<void(Record const&)>;
+
+    AsyncBackend(AsyncOptions const& options, WriteFunction writeFunc) :
+        queue(options.capacity),
+        policy(options.overflowPolicy),
+        write(std::move(writeFunc))
+    {
+        thread = std::thread([this](){ run(); });
+    }
+
+    ~AsyncBackend() { stop(); }
+
+    //! Pushes a new record. Returns false if the record was dropped
+    bool push(Level level,
+              char const* message,
+              std::size_t size,
+              std::string const& id,
+              std::time_t time,
+              std::uint32_t format = 0,
+              SourceLocation const& location = {},
+              ThreadInfo const& thread = {},
+              Context const& context = {},
+              std::vector<Field> const& fields = {})
+    {
+        // copy into the slot, which keeps the capacity of previous records
+        auto fill = [&](Record& record){
+            record.level = level;
+            record.message.assign(message, size);
+            record.id.assign(id);
+            record.time = time;
+            record.format = format;
+            record.location = location;
+            record.thread = thread;
+            record.context = context;
+            record.fields.assign(fields.begin(), fields.end());
+        };
+
+        while (!queue.tryPush(fill))
+        {
+            switch (policy)
+            {
+            case DropNewestOnOverflow:
+                droppedNewest.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            case DropOldestOnOverflow:
+                if (queue.tryPop([](Record&){}))
+                {
+                    droppedOldest.fetch_add(1, std::memory_order_relaxed);
+                    processed.fetch_add(1, std::memory_order_seq_cst);
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+                break;
+            case BlockOnOverflow:
+            default:
+                if (stopping.load(std::memory_order_seq_cst))
+                {
+                    // the backend may have exited already, thus nobody would
+                    // free a slot
+                    Record record;
+                    fill(record);
+                    writeRecord(record);
+                    return true;
+                }
+                wakeBackend();
+                std::this_thread::yield();
+                break;
+            }
+        }
+
+        pushed.fetch_add(1, std::memory_order_seq_cst);
+        if (stopping.load(std::memory_order_seq_cst))
+        {
+            // the record may have missed the final drain of the backend
+            Record record;
+            drain(record);
+            return true;
+        }
+        if (sleeping.load(std::memory_order_seq_cst)) wakeBackend();
+        return true;
+    }
+
+    //! Blocks until all records claimed before this call were written
+    void flush()
+    {
+        size_t target = queue.enqueueCount();
+
+        std::unique_lock<std::mutex> lock(mutex);
+        ++flushWaiters;
+        wakeup.notify_one();
+        flushed.wait(lock, [&](){
+            return processed.load(std::memory_order_seq_cst) >= target ||
+                   !running;
+        });
+        --flushWaiters;
+    }
+
+    //! Stops the backend thread after all queued records were written
+    void stop()
+    {
+        // producers write their records themselves from now on
+        stopping.store(true, std::memory_order_seq_cst);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopRequested = true;
+            wakeup.notify_one();
+        }
+        if (thread.joinable()) thread.join();
+
+        // write records that were pushed after the thread has exited. A
+        // producer that did not see the stopping flag has counted its record
+        // before, thus this load makes the record visible to the drain.
+        pushed.load(std::memory_order_seq_cst);
+        drain(current);
+    }
+
+    AsyncStats stats() const
+    {
+        AsyncStats s;
+        s.droppedNewest = droppedNewest.load(std::memory_order_relaxed);
+        s.droppedOldest = droppedOldest.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+
+    detail::BoundedQueue<Record> queue;
+    OverflowPolicy policy;
+    WriteFunction write;
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable flushed;
+    int flushWaiters{0};
+    bool stopRequested{false};
+    bool running{true};
+
+    /// record that is currently written by the backend
+    Record current;
+
+    std::atomic<bool> sleeping{false};
+    /// set once the backend is stopped
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<uint64_t> processed{0};
+    std::atomic<uint64_t> droppedNewest{0};
+    std::atomic<uint64_t> droppedOldest{0};
+
+    void wakeBackend()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        wakeup.notify_one();
+    }
+
+    //! Writes the record to the destinations
+    void writeRecord(Record const& record)
+    {
+        try
+        {
+            write(record);
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << "GtLogging: exception in destination: "
+                      << e.what() << '\n';
+        }
+        catch (...)
+        {
+            std::cerr << "GtLogging: unknown exception in destination!\n";
+        }
+    }
+
+    //! Writes all available records using `buffer`. Returns whether any
+    //! record was written
+    bool drain(Record& buffer)
+    {
+        bool any = false;
+        // swap the record out of its slot, so that the slot is released
+        // before calling the destinations
+        while (queue.tryPop([&](Record& record){ std::swap(buffer, record); }))
+        {
+            writeRecord(buffer);
+            processed.fetch_add(1, std::memory_order_seq_cst);
+            any = true;
+        }
+        return any;
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            drain(current);
+
+            std::unique_lock<std::mutex> lock(mutex);
+            if (flushWaiters > 0) flushed.notify_all();
+
+            sleeping.store(true, std::memory_order_seq_cst);
+            if (pushed.load(std::memory_order_seq_cst) !=
+                processed.load(std::memory_order_seq_cst))
+            {
+                // new records arrived in the meantime
+                sleeping.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            if (stopRequested) break;
+
+            wakeup.wait(lock);
+            sleeping.store(false, std::memory_order_relaxed);
+        }
+
+        running = false;
+        flushed.notify_all();
+    }
+};
+
+//! Counters of the messages dropped by the budget
+struct BudgetCounters
+{
+    uint64_t trace = 0;
+    uint64_t debug = 0;
+    uint64_t info = 0;
+    uint64_t bytes = 0;
+
+    uint64_t messages() const { return trace + debug + info; }
+};
+
+//! Same as above, updated without locking
+struct AtomicBudgetCounters
+{
+    std::atomic<uint64_t> trace{0};
+    std::atomic<uint64_t> debug{0};
+    std::atomic<uint64_t> info{0};
+    std::atomic<uint64_t> bytes{0};
+
+    void count(Level level, std::size_t size)
+    {
+        std::atomic<uint64_t>& counter = level <= TraceLevel ? trace :
+                                         level <= DebugLevel ? debug : info;
+        counter.fetch_add(1, std::memory_order_relaxed);
+        if (size > 0) bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    uint64_t messages() const
+    {
+        return trace.load(std::memory_order_relaxed) +
+               debug.load(std::memory_order_relaxed) +
+               info.load(std::memory_order_relaxed);
+    }
+
+    //! Returns the counters and resets them
+    BudgetCounters take()
+    {
+        BudgetCounters c;
+        c.trace = trace.exchange(0, std::memory_order_relaxed);
+        c.debug = debug.exchange(0, std::memory_order_relaxed);
+        c.info = info.exchange(0, std::memory_order_relaxed);
+        c.bytes = bytes.exchange(0, std::memory_order_relaxed);
+        return c;
+    }
+
+    BudgetCounters get() const
+    {
+        BudgetCounters c;
+        c.trace = trace.load(std::memory_order_relaxed);
+        c.debug = debug.load(std::memory_order_relaxed);
+        c.info = info.load(std::memory_order_relaxed);
+        c.bytes = bytes.load(std::memory_order_relaxed);
+        return c;
+    }
+};
+
+/// time in nanoseconds of the steady clock
+using Nanoseconds = std::int64_t;
+
+Nanoseconds
+steadyNow()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//! Token bucket of the budget, which is updated without locking. The bucket
+//! is represented by the time at which it is full again, which each message
+//! advances by its cost (generic cell rate algorithm).
+class Bucket
+{
+public:
+
+    void reset(double rate, double burst)
+    {
+        double interval = rate > 0 ? 1e9 / rate : 0;
+        m_interval.store(interval, std::memory_order_relaxed);
+        m_capacity.store(static_cast<Nanoseconds>(
+                             std::max(burst * 1e9, interval)),
+                         std::memory_order_relaxed);
+        m_full.store(0, std::memory_order_relaxed);
+    }
+
+    bool isLimited() const
+    {
+        return m_interval.load(std::memory_order_relaxed) > 0;
+    }
+
+    //! Returns whether the cost fits into the bucket, keeping the given
+    //! fraction of the bucket in reserve. A cost exceeding the bucket fits
+    //! if the bucket is full.
+    bool fits(double cost, double reserve, Nanoseconds now) const
+    {
+        return fits(m_full.load(std::memory_order_relaxed), cost, reserve,
+                    now);
+    }
+
+    //! Consumes the cost if it fits (see `fits`)
+    bool take(double cost, double reserve, Nanoseconds now)
+    {
+        if (!isLimited()) return true;
+
+        Nanoseconds full = m_full.load(std::memory_order_relaxed);
+        do
+        {
+            if (!fits(full, cost, reserve, now)) return false;
+        }
+        while (!m_full.compare_exchange_weak(
+                   full, std::max(full, now) + duration(cost),
+                   std::memory_order_relaxed));
+        return true;
+    }
+
+    //! Consumes the cost unconditionally. The bucket is empty at most.
+    void consume(double cost, Nanoseconds now)
+    {
+        if (!isLimited()) return;
+
+        Nanoseconds empty = now + m_capacity.load(std::memory_order_relaxed);
+        Nanoseconds full = m_full.load(std::memory_order_relaxed);
+        Nanoseconds next;
+        do
+        {
+            next = std::min(std::max(full, now) + duration(cost), empty);
+            if (next <= full) return;
+        }
+        while (!m_full.compare_exchange_weak(full, next,
+                                             std::memory_order_relaxed));
+    }
+
+    //! Returns the cost taken by a message that was dropped nonetheless
+    void refund(double cost)
+    {
+        if (isLimited()) m_full.fetch_sub(duration(cost),
+                                          std::memory_order_relaxed);
+    }
+
+    double tokens(Nanoseconds now) const
+    {
+        double interval = m_interval.load(std::memory_order_relaxed);
+        if (interval <= 0) return 0;
+
+        Nanoseconds used = std::max<Nanoseconds>(
+            m_full.load(std::memory_order_relaxed) - now, 0);
+        Nanoseconds left = std::max<Nanoseconds>(
+            m_capacity.load(std::memory_order_relaxed) - used, 0);
+        return static_cast<double>(left) / interval;
+    }
+
+private:
+
+    /// nanoseconds per token, 0 denotes no limit
+    std::atomic<double> m_interval{0};
+    /// nanoseconds of a full bucket
+    std::atomic<Nanoseconds> m_capacity{0};
+    /// time at which the bucket is full again
+    std::atomic<Nanoseconds> m_full{0};
+
+    Nanoseconds duration(double cost) const
+    {
+        return static_cast<Nanoseconds>(
+            cost * m_interval.load(std::memory_order_relaxed));
+    }
+
+    bool fits(Nanoseconds full, double cost, double reserve,
+              Nanoseconds now) const
+    {
+        if (!isLimited() || full <= now) return true;
+
+        auto allowed = static_cast<Nanoseconds>(
+            (1.0 - reserve) * m_capacity.load(std::memory_order_relaxed));
+        return full + duration(cost) - now <= allowed;
+    }
+};
+
+//! Process wide budget of the logged messages. Messages are admitted
+//! without locking, the mutex only guards the options.
+class Budget
+{
+public:
+
+    bool isEnabled() const
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    void set(LogBudget const& budget)
+    {
+        MutexLocker lock(mutex);
+
+        double burst = std::chrono::duration<double>(budget.burst).count();
+
+        options = budget;
+        messages.reset(budget.messagesPerSecond, burst);
+        bytes.reset(budget.bytesPerSecond, burst);
+        dropped.take();
+        pending.take();
+        summaryInterval.store(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                budget.summaryInterval).count(),
+            std::memory_order_relaxed);
+        lastSummary.store(steadyNow(), std::memory_order_relaxed);
+
+        enabled.store(messages.isLimited() || bytes.isLimited(),
+                      std::memory_order_relaxed);
+        detail::controlBlock.shedLevel.store(0, std::memory_order_relaxed);
+    }
+
+    LogBudget get() const
+    {
+        MutexLocker lock(mutex);
+        return options;
+    }
+
+    //! Returns whether a message of the given level and size fits into the
+    //! budget and consumes its tokens. Lower levels keep a larger fraction
+    //! of the buckets in reserve, thus they are dropped first and shed by
+    //! the level checks of the statements until the buckets were refilled.
+    //! Warnings and above are always admitted.
+    bool admit(Level level, std::size_t size)
+    {
+        Nanoseconds now = steadyNow();
+        auto cost = static_cast<double>(size);
+
+        if (level >= WarningLevel)
+        {
+            messages.consume(1, now);
+            bytes.consume(cost, now);
+            return true;
+        }
+
+        double r = reserve(level);
+        if (messages.take(1, r, now))
+        {
+            if (bytes.take(cost, r, now)) return true;
+            messages.refund(1);
+        }
+
+        dropped.count(level, size);
+        pending.count(level, size);
+        shed(level);
+        return false;
+    }
+
+    //! Returns whether a statement of the given level is still shed, i.e.
+    //! not even a message of a single byte fits. Counts it as dropped in
+    //! this case.
+    bool isShed(Level level)
+    {
+        Nanoseconds now = steadyNow();
+
+        // the levels, that fit again, are no longer shed
+        int highest = 0;
+        for (Level l : {InfoLevel, DebugLevel, TraceLevel})
+        {
+            if (!messages.fits(1, reserve(l), now) ||
+                !bytes.fits(1, reserve(l), now))
+            {
+                highest = l;
+                break;
+            }
+        }
+        detail::controlBlock.shedLevel.store(highest,
+                                             std::memory_order_relaxed);
+
+        if (level > highest) return false;
+
+        dropped.count(level, 0);
+        pending.count(level, 0);
+        return true;
+    }
+
+    //! Returns the messages dropped since the last summary if the summary
+    //! is due or forced
+    BudgetCounters summary(bool force)
+    {
+        if (pending.messages() == 0) return {};
+
+        Nanoseconds now = steadyNow();
+        Nanoseconds last = lastSummary.load(std::memory_order_relaxed);
+        if (!force &&
+            now - last < summaryInterval.load(std::memory_order_relaxed))
+        {
+            return {};
+        }
+        // only a single thread logs the summary
+        if (!lastSummary.compare_exchange_strong(last, now,
+                                                 std::memory_order_relaxed))
+        {
+            return {};
+        }
+        return pending.take();
+    }
+
+    LogBudgetState state() const
+    {
+        Nanoseconds now = steadyNow();
+        BudgetCounters d = dropped.get();
+
+        LogBudgetState s;
+        s.enabled = isEnabled();
+        s.messageTokens = messages.tokens(now);
+        s.byteTokens = bytes.tokens(now);
+        s.droppedTrace = d.trace;
+        s.droppedDebug = d.debug;
+        s.droppedInfo = d.info;
+        s.droppedBytes = d.bytes;
+        return s;
+    }
+
+private:
+
+    /// allows skipping the budget
+    std::atomic<bool> enabled{false};
+    mutable std::mutex mutex;
+    LogBudget options;
+    Bucket messages;
+    Bucket bytes;
+    /// dropped since the budget was set
+    AtomicBudgetCounters dropped;
+    /// dropped since the last summary
+    AtomicBudgetCounters pending;
+    std::atomic<Nanoseconds> summaryInterval{0};
+    std::atomic<Nanoseconds> lastSummary{0};
+
+    //! Fraction of the buckets kept in reserve for higher levels
+    static double reserve(Level level)
+    {
+        return level <= TraceLevel ? 2.0 / 3.0 :
+               level <= DebugLevel ? 1.0 / 3.0 : 0.0;
+    }
+
+    //! Sheds the level (and all lower levels) in the level checks of the
+    //! statements
+    static void shed(Level level)
+    {
+        std::atomic<int>& shedLevel = detail::controlBlock.shedLevel;
+        int current = shedLevel.load(std::memory_order_relaxed);
+        while (current < level &&
+               !shedLevel.compare_exchange_weak(current, level,
+                                                std::memory_order_relaxed))
+        {}
+    }
+};
+
+//! Returns the process wide budget of the messages
+Budget&
+processBudget()
+{
+    // never destroyed, as it is checked by the logging statements
+    static auto* budget = new Budget;
+    return *budget;
+}
+
+//! Logs the summary of the dropped messages as a warning
+void
+logBudgetSummary(BudgetCounters const& summary)
+{
+    if (summary.messages() == 0) return;
+
+    static char const text[] = "messages dropped by the log budget";
+
+    Stream s{WarningLevel};
+    s.append(text, sizeof(text) - 1)
+        << field("dropped", summary.messages())
+        << field("trace", summary.trace)
+        << field("debug", summary.debug)
+        << field("info", summary.info)
+        << field("bytes", summary.bytes);
+    Logger::instance().log(WarningLevel, s, "GtLogging");
+}
+
+} // namespace
+
 struct Logger::Impl
 {
     Impl()
@@ -96,10 +901,131 @@ struct Logger::Impl
         destinations.reserve(2);
     }
 
-    Level level{InfoLevel};
-    int verbosity{Silent};
     std::mutex logMutex;
     std::vector<DestinationEntry> destinations;
+    /// levels accepted by any destination (bitfield), allows checking them
+    /// without locking
+    std::atomic<int> acceptedLevels{0};
+
+    /// backend of the async mode (null if disabled)
+    std::atomic<AsyncBackend*> async{nullptr};
+    /// guards enabling/disabling the async mode
+    std::mutex asyncMutex;
+    /// backends are kept alive until shutdown, as producers may still
+    /// reference them
+    std::vector<std::unique_ptr<AsyncBackend>> asyncBackends;
+
+    //! Returns whether the message fits into the budget. Logs the summary of
+    //! the dropped messages if it is due.
+    static bool admit(Level level, std::size_t size)
+    {
+        Budget& b = processBudget();
+        if (!b.isEnabled()) return true;
+
+        bool admitted = b.admit(level, size);
+        logBudgetSummary(b.summary(false));
+        return admitted;
+    }
+
+    //! Forwards the message to the async backend or writes it directly
+    void log(Level level, std::string const& message, std::string const& id,
+             SourceLocation const& location = {},
+             std::vector<Field> const& fields = {})
+    {
+        if (!admit(level, message.size())) return;
+
+        // get time
+        std::time_t rawtime;
+        std::time(&rawtime);
+
+        ThreadInfo const& thread = currentThread();
+        Context context = currentContext();
+
+        if (AsyncBackend* backend = async.load(std::memory_order_acquire))
+        {
+            backend->push(level, message.data(), message.size(), id, rawtime,
+                          0, location, thread, context, fields);
+            return;
+        }
+
+        write(message, level,
+              Details{id, localTime(rawtime), location, thread,
+                      std::move(context), fields});
+    }
+
+    //! Forwards the binary record to the async backend or formats and
+    //! writes it directly
+    void logBinary(Level level, std::uint32_t format,
+                   char const* data, std::size_t size, std::time_t rawtime,
+                   ThreadInfo const& thread)
+    {
+        if (!admit(level, size)) return;
+
+        // empty for real-time records, as they are forwarded by the backend
+        // thread of the real-time mode
+        Context context = currentContext();
+
+        if (AsyncBackend* backend = async.load(std::memory_order_acquire))
+        {
+            static std::string const noId;
+            backend->push(level, data, size, noId, rawtime, format, {},
+                          thread, context);
+            return;
+        }
+
+        writeBinary(level, format, data, size, rawtime, thread, context);
+    }
+
+    //! Formats the binary record and sends it to all the destinations
+    void writeBinary(Level level, std::uint32_t format,
+                     char const* data, std::size_t size, std::time_t time,
+                     ThreadInfo const& thread, Context const& context)
+    {
+        BinaryFormat const* info = detail::binaryFormat(format);
+        std::string message;
+        if (!info ||
+            !detail::formatBinaryRecord(info->format, data, size, message))
+        {
+            std::cerr << "GtLogging: invalid binary record!\n";
+            return;
+        }
+
+        write(message, level, Details{info->module, localTime(time),
+                                      detail::binaryLocation(*info), thread,
+                                      context});
+    }
+
+    //! Determines the levels accepted by the destinations. Mutex must be
+    //! locked
+    void updateAcceptedLevels()
+    {
+        acceptedLevelsOutdated.exchange(false, std::memory_order_acquire);
+
+        int levels = 0;
+        for (Level level : {TraceLevel, DebugLevel, InfoLevel,
+                            WarningLevel, ErrorLevel, FatalLevel})
+        {
+            if (std::any_of(destinations.cbegin(), destinations.cend(),
+                            [level](DestinationEntry const& dest){
+                return dest.ptr->accepts(level);
+            }))
+            {
+                levels |= levelToInt(level);
+            }
+        }
+        acceptedLevels.store(levels, std::memory_order_relaxed);
+    }
+
+    //! Sends the message to all the destinations
+    void write(std::string const& message, Level level, Details const& details)
+    {
+        MutexLocker lock(logMutex);
+
+        std::for_each(destinations.begin(), destinations.end(),
+                      [&](DestinationEntry const& dest){
+            dest.ptr->write(message, level, details);
+        });
+    }
 };
 
 Logger::Logger() : pimpl(std::make_unique<Impl>()) { }
@@ -111,7 +1037,18 @@ Logger::instance()
     return instance;
 }
 
-Logger::~Logger() = default;
+Logger::~Logger()
+{
+    // real-time records may be forwarded to the async backend
+    detail::stopRealtime();
+
+    disableAsync();
+
+    // write records that were pushed to disabled backends
+    for (auto& backend : pimpl->asyncBackends) backend->stop();
+
+    detail::flushBinaryLog();
+}
 
 bool
 Logger::addDestination(std::string id, DestinationPtr destination)
@@ -138,6 +1075,7 @@ Logger::addDestination(std::string id, DestinationPtr destination)
 
     MutexLocker lock(pimpl->logMutex);
     pimpl->destinations.push_back({ std::move(id), std::move(destination) });
+    pimpl->updateAcceptedLevels();
     return true;
 }
 
@@ -176,9 +1114,12 @@ Logger::removeDestination(const std::string& id)
 
     MutexLocker lock(pimpl->logMutex);
 
-    return erase(pimpl->destinations, [&](DestinationEntry const& dest){
+    bool removed = erase(pimpl->destinations,
+                         [&](DestinationEntry const& dest){
         return dest.id == id;
     });
+    if (removed) pimpl->updateAcceptedLevels();
+    return removed;
 }
 
 bool
@@ -221,46 +1162,46 @@ Logger::destinationIds() const
     return ids;
 }
 
-void
-Logger::setLoggingLevel(Level newLevel)
+bool
+Logger::acceptsLevel(Level level) const
 {
-    pimpl->level = newLevel;
+    if (acceptedLevelsOutdated.load(std::memory_order_relaxed))
+    {
+        // does not wait for destinations that are being written to
+        std::unique_lock<std::mutex> lock(pimpl->logMutex, std::try_to_lock);
+        if (!lock.owns_lock()) return true;
+
+        pimpl->updateAcceptedLevels();
+    }
+    return pimpl->acceptedLevels.load(std::memory_order_relaxed) &
+           levelToInt(level);
 }
 
-Level Logger::loggingLevel() const
+void
+Logger::log(Level level, std::string message, std::string id)
 {
-    return pimpl->level;
+    pimpl->log(level, message, id);
 }
 
 void
-Logger::setVerbosity(int verbosity)
+Logger::log(Level level, Stream const& stream, std::string const& id)
 {
-    pimpl->verbosity = std::move(verbosity);
+    pimpl->log(level, stream.message(), id, {}, stream.fields());
 }
 
-int
-Logger::verbosity() const
+void
+Logger::log(Level level, Stream const& stream, std::string const& id,
+            SourceLocation const& location)
 {
-    return pimpl->verbosity;
+    pimpl->log(level, stream.message(), id, location, stream.fields());
 }
 
 void
-Logger::log(Level level, std::string message, std::string id)
+Logger::logBinary(Level level, std::uint32_t format,
+                  char const* data, std::size_t size, std::time_t time,
+                  ThreadInfo const& thread)
 {
-    // get time
-    std::tm timebuf;
-    std::time_t rawtime;
-    std::time(&rawtime);
-
-// https://en.cppreference.com/w/c/chrono/localtime
-#ifdef _WIN32
-    std::tm* time = &timebuf;
-    localtime_s(&timebuf, &rawtime);
-#else
-    tm* time = localtime_r(&rawtime, &timebuf);
-#endif
-
-    write(message, level, Details{id, *time});
+    pimpl->logBinary(level, format, data, size, time, thread);
 }
 
 //! Sends the message to all the destinations. The level for this message is passed in case
@@ -268,31 +1209,125 @@ Logger::log(Level level, std::string message, std::string id)
 void
 Logger::write(std::string const& message, Level level, Details details)
 {
-    MutexLocker lock(pimpl->logMutex);
+    pimpl->write(message, level, details);
+}
+
+bool
+Logger::enableAsync(AsyncOptions options)
+{
+    MutexLocker lock(pimpl->asyncMutex);
 
-    std::for_each(pimpl->destinations.begin(), pimpl->destinations.end(),
-                  [&](DestinationEntry const& dest){
-        dest.ptr->write(message, level, details);
+    if (pimpl->async.load()) return false;
+
+    Impl* impl = pimpl.get();
+    auto backend = std::make_unique<AsyncBackend>(options,
+                                                  [impl](Record const& record){
+        if (record.format != 0)
+        {
+            return impl->writeBinary(record.level, record.format,
+                                     record.message.data(),
+                                     record.message.size(), record.time,
+                                     record.thread, record.context);
+        }
+        impl->write(record.message, record.level,
+                    Details{record.id, localTime(record.time),
+                            record.location, record.thread,
+                            record.context, record.fields});
     });
+    pimpl->async.store(backend.get(), std::memory_order_release);
+    pimpl->asyncBackends.push_back(std::move(backend));
+    return true;
 }
 
 void
-Logger::Helper::writeToLog()
+Logger::disableAsync()
 {
-    if (!gtStream.mayLog()) return;
+    MutexLocker lock(pimpl->asyncMutex);
 
-    auto message = gtStream.str();
-    if (message.empty()) return;
+    AsyncBackend* backend = pimpl->async.exchange(nullptr);
+    if (!backend) return;
 
-    Logger::instance().log(level, std::move(message), std::move(id));
+    backend->stop();
 }
 
-} // end namespace log
+bool
+Logger::isAsync() const
+{
+    return pimpl->async.load(std::memory_order_acquire);
+}
 
-} // end namespace gt
+void
+Logger::flush()
+{
+    detail::flushRealtime();
+    detail::flushBinaryLog();
+
+    // messages dropped by the budget, that were not summarized yet
+    logBudgetSummary(processBudget().summary(true));
+
+    if (AsyncBackend* async = pimpl->async.load(std::memory_order_acquire))
+    {
+        async->flush();
+    }
+}
+
+AsyncStats
+Logger::asyncStats() const
+{
+    MutexLocker lock(pimpl->asyncMutex);
+
+    AsyncStats stats;
+    for (auto const& backend : pimpl->asyncBackends)
+    {
+        auto s = backend->stats();
+        stats.droppedNewest += s.droppedNewest;
+        stats.droppedOldest += s.droppedOldest;
+    }
+    return stats;
+}
+
+void
+Logger::setBudget(LogBudget const& budget)
+{
+    // messages dropped by the previous budget
+    logBudgetSummary(processBudget().summary(true));
+    processBudget().set(budget);
+}
+
+LogBudget
+Logger::budget() const
+{
+    return processBudget().get();
+}
+
+LogBudgetState
+Logger::budgetState() const
+{
+    return processBudget().state();
+}
 
 bool
-gt::log::Stream::mayLog(int level)
+detail::isBudgetExceeded(Level level) noexcept
 {
-    return level <= Logger::instance().verbosity();
+    Budget& b = processBudget();
+    if (!b.isEnabled())
+    {
+        controlBlock.shedLevel.store(0, std::memory_order_relaxed);
+        return false;
+    }
+    return b.isShed(level);
 }
+
+void
+Logger::Helper::writeToLog()
+{
+    if (!gtStream.mayLog()) return;
+
+    if (gtStream.message().empty()) return;
+
+    Logger::instance().log(level, gtStream, id, location);
+}
+
+} // end namespace log
+
+} // end namespace gt
@@ -32,8 +32,23 @@
 
 #include "gt_loglevel.h"
 #include "gt_logstream.h"
+#include "gt_logformat.h"
+#include "gt_logbinary.h"
+#include "gt_logcontext.h"
+#include "gt_logfield.h"
+#include "gt_loghash.h"
+#include "gt_lograte.h"
+#include "gt_logsample.h"
+#include "gt_logemergency.h"
+#include "gt_logrealtime.h"
+#include "gt_logthread.h"
 
 #include <vector>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 #include "gt_logdestconsole.h"
 #include "gt_logdestfile.h"
@@ -48,6 +63,14 @@
 #define GT_MODULE_ID ""
 #endif
 
+// minimum logging level that is compiled in (gt::log::Level or an integer).
+// Statements below this level are removed by the compiler including their
+// arguments. To override a global definition in a single file, undefine the
+// macro and define it again before including this header.
+#ifndef GT_LOG_MIN_LEVEL
+#define GT_LOG_MIN_LEVEL gt::log::TraceLevel
+#endif
+
 namespace gt
 {
 
@@ -56,34 +79,166 @@ namespace log
 
 using hash_t = size_t;
 
+/**
+ * @brief Hashes a message of `gtLogOnce` using a 64-bit XXH64 hash. The
+ * message, the id and the level are hashed in place, prefixed with their
+ * sizes, thus different combinations (e.g. "ab" + "c" and "a" + "bc") are
+ * distinct inputs. Does not allocate.
+ *
+ * Messages with equal hashes are considered equal, thus a collision
+ * suppresses the second message. For n distinct messages the probability of
+ * any collision is about n^2 / 2^65 (e.g. 3e-10 for 100,000 messages). On
+ * platforms with a 32-bit `size_t` the hash is truncated and the probability
+ * is about n^2 / 2^33.
+ */
 GT_LOGGING_EXPORT
 hash_t hash(std::string const& msg, std::string const& id, Level level);
 
+//! Behaviour of the asynchronous logging mode if the queue is full
+enum OverflowPolicy
+{
+    BlockOnOverflow      = 0, // caller waits until a slot becomes free
+    DropNewestOnOverflow = 1, // the new message is discarded
+    DropOldestOnOverflow = 2  // the oldest queued message is discarded
+};
+
+//! Options for the asynchronous logging mode
+struct AsyncOptions
+{
+    /// Maximum number of queued messages (rounded up to a power of two)
+    size_t capacity = 8192;
+    /// Behaviour if the queue is full
+    OverflowPolicy overflowPolicy = BlockOnOverflow;
+};
+
+//! Counters of the asynchronous logging mode
+struct AsyncStats
+{
+    /// Number of messages discarded by `DropNewestOnOverflow`
+    uint64_t droppedNewest = 0;
+    /// Number of messages discarded by `DropOldestOnOverflow`
+    uint64_t droppedOldest = 0;
+};
+
+//! Process wide budget of the logged messages (see `Logger::setBudget`).
+//! Both limits are enforced using token buckets, which hold the messages or
+//! bytes of a burst.
+struct LogBudget
+{
+    /// Sustained number of messages per second, 0 denotes no limit
+    double messagesPerSecond = 0;
+    /// Sustained number of bytes per second (of the message text), 0 denotes
+    /// no limit
+    double bytesPerSecond = 0;
+    /// Duration of a burst, which is admitted in full, i.e. the size of the
+    /// buckets
+    std::chrono::milliseconds burst{1000};
+    /// Minimum interval of the summaries of the dropped messages
+    std::chrono::milliseconds summaryInterval{10000};
+};
+
+//! Current state of the log budget. The counters are reset when the budget
+//! is set.
+struct LogBudgetState
+{
+    /// Whether a budget is set
+    bool enabled = false;
+    /// Tokens left in the message bucket
+    double messageTokens = 0;
+    /// Tokens left in the byte bucket
+    double byteTokens = 0;
+    /// Number of dropped trace messages
+    uint64_t droppedTrace = 0;
+    /// Number of dropped debug messages
+    uint64_t droppedDebug = 0;
+    /// Number of dropped info messages
+    uint64_t droppedInfo = 0;
+    /// Number of bytes of the dropped messages. Messages shed by the level
+    /// checks were not built, thus their size is unknown.
+    uint64_t droppedBytes = 0;
+};
+
+//! Options of the cache of `gtLogOnce`. Evicted or expired messages may be
+//! logged again.
+struct LogOnceCacheOptions
+{
+    /// Maximum number of messages (approximately), 0 denotes no limit. The
+    /// least recently used messages are evicted first.
+    size_t capacity = 0;
+    /// Time after which a message may be logged again, 0 denotes never
+    std::chrono::milliseconds timeToLive{0};
+};
+
+//! Describes a logging statement that was registered at runtime
+struct CallSite
+{
+    /// source file of the statement
+    std::string file;
+    /// line of the statement
+    int line = 0;
+    /// level of the statement
+    Level level = InfoLevel;
+    /// module id of the statement
+    std::string module;
+    /// current mode of the statement
+    CallSiteMode mode = CallSiteDefault;
+};
+
+//! Selects logging statements. Empty members match any statement.
+struct CallSiteFilter
+{
+    /// file name or trailing part of the path (e.g. "core/gt_object.cpp")
+    std::string file;
+    /// first line (inclusive)
+    int firstLine = 0;
+    /// last line (inclusive)
+    int lastLine = std::numeric_limits<int>::max();
+    /// module id, may end with a '*' to match by prefix
+    std::string module;
+};
+
 //! Main logger instance
 class Logger
 {
 public:
 
     //! Default cache to store the hashes of the messages that should be
-    //! logged once. This cache is thread safe, thus may not have optimal
-    //! performance. Look up time is O(n).
+    //! logged once. This cache is thread safe. The hashes are distributed
+    //! over independently locked shards, thus threads rarely contend. Look up
+    //! time is O(1). The cache is unbounded by default (see
+    //! `LogOnceCacheOptions`).
     class DefaultCache
     {
     public:
         using value_type = hash_t;
 
         GT_LOGGING_EXPORT DefaultCache();
+        GT_LOGGING_EXPORT explicit DefaultCache(
+            LogOnceCacheOptions const& options);
         GT_LOGGING_EXPORT ~DefaultCache();
 
         //! Appends a new hash entry to the cache.
         GT_LOGGING_EXPORT void append(hash_t hash);
 
+        //! Inserts the hash. Returns false if it exists already. Unlike
+        //! `find` and `append`, the check and the insertion are atomic.
+        GT_LOGGING_EXPORT bool insert(hash_t hash);
+
         //! Clears all saved hashes
         GT_LOGGING_EXPORT void clear();
 
         //! Returns whether the hash exists in the cache
         GT_LOGGING_EXPORT bool find(hash_t hash) const noexcept;
 
+        //! Returns the number of saved hashes (including expired ones that
+        //! were not evicted yet)
+        GT_LOGGING_EXPORT size_t size() const;
+
+        //! Sets the capacity and the time to live. Evicts hashes exceeding
+        //! the new capacity. Hashes inserted without a time to live expire
+        //! relative to this call.
+        GT_LOGGING_EXPORT void setOptions(LogOnceCacheOptions const& options);
+
     private:
         struct Impl;
         std::unique_ptr<Impl> pimpl;
@@ -128,6 +283,58 @@ public:
     GT_LOGGING_EXPORT
     Level loggingLevel() const;
 
+    //! Overrides the logging level for a module. The module id may end with
+    //! a '*' to match all modules with the given prefix (e.g.
+    //! "gtlab.core.*"). Exact matches take precedence over the longest
+    //! matching prefix.
+    GT_LOGGING_EXPORT
+    void setModuleLoggingLevel(std::string const& module, Level newLevel);
+
+    //! Removes an override previously set using `setModuleLoggingLevel`.
+    //! Returns true if an override was removed.
+    GT_LOGGING_EXPORT
+    bool removeModuleLoggingLevel(std::string const& module);
+
+    //! Removes all module specific logging levels
+    GT_LOGGING_EXPORT
+    void clearModuleLoggingLevels();
+
+    //! Returns the effective logging level of a module
+    GT_LOGGING_EXPORT
+    Level moduleLoggingLevel(std::string const& module) const;
+
+    //! Overrides the sampling rate of the sampled logging statements of a
+    //! module (see `gtTraceSampled`). The rate is clamped to [0, 1], the
+    //! module id is matched like in `setModuleLoggingLevel`.
+    GT_LOGGING_EXPORT
+    void setModuleSamplingRate(std::string const& module, double rate);
+
+    //! Removes an override previously set using `setModuleSamplingRate`.
+    //! Returns true if an override was removed.
+    GT_LOGGING_EXPORT
+    bool removeModuleSamplingRate(std::string const& module);
+
+    //! Removes all module specific sampling rates
+    GT_LOGGING_EXPORT
+    void clearModuleSamplingRates();
+
+    //! Sets the mode of all logging statements matched by the filter. The
+    //! filter is also applied to statements that are registered later on,
+    //! i.e. that have not been executed yet. Later calls take precedence, a
+    //! call with an identical filter replaces the previous one. Returns the
+    //! number of registered statements that were matched.
+    GT_LOGGING_EXPORT
+    size_t setCallSiteMode(CallSiteFilter const& filter, CallSiteMode mode);
+
+    //! Resets all logging statements to `CallSiteDefault`
+    GT_LOGGING_EXPORT
+    void clearCallSiteModes();
+
+    //! Returns all logging statements that have been registered so far.
+    //! Statements are registered once they are executed for the first time.
+    GT_LOGGING_EXPORT
+    std::vector<CallSite> callSites() const;
+
     //! Sets the verbosity level of the logger (from 0 ... 9)
     GT_LOGGING_EXPORT
     void setVerbosity(int verbosity);
@@ -136,10 +343,132 @@ public:
     GT_LOGGING_EXPORT
     int verbosity() const;
 
+    //! Returns whether any destination accepts messages of the given level.
+    //! The accepted levels are cached when destinations are added or removed
+    //! or their filter changes, thus the check does not lock.
+    GT_LOGGING_EXPORT
+    bool acceptsLevel(Level level) const;
+
     //! Method to log a message to all destinations
     GT_LOGGING_EXPORT
     void log(Level level, std::string message, std::string id = GT_MODULE_ID);
 
+    //! Logs the message of the stream without copying it
+    GT_LOGGING_EXPORT
+    void log(Level level, Stream const& stream, std::string const& id);
+
+    //! Same as above, passing the location of the logging statement to the
+    //! destinations
+    GT_LOGGING_EXPORT
+    void log(Level level, Stream const& stream, std::string const& id,
+             SourceLocation const& location);
+
+    //! Enables the asynchronous logging mode: messages are pushed into a
+    //! bounded lock-free queue and written to the destinations by a backend
+    //! thread. Returns false if the mode is already enabled. Destinations are
+    //! called from the backend thread only.
+    GT_LOGGING_EXPORT
+    bool enableAsync(AsyncOptions options = {});
+
+    //! Disables the asynchronous logging mode. All queued messages are written
+    //! before this function returns. Should not be called while other threads
+    //! are logging, as their messages may be delayed until shutdown.
+    GT_LOGGING_EXPORT
+    void disableAsync();
+
+    //! Returns whether the asynchronous logging mode is enabled
+    GT_LOGGING_EXPORT
+    bool isAsync() const;
+
+    //! Blocks until all messages that were logged before this call have been
+    //! written to the destinations. Does nothing in synchronous mode. Flushes
+    //! the records of real-time logging statements and the binary log file
+    //! as well.
+    GT_LOGGING_EXPORT
+    void flush();
+
+    //! Returns the drop counters of the asynchronous logging mode
+    GT_LOGGING_EXPORT
+    AsyncStats asyncStats() const;
+
+    //! Limits the rate of the logged messages process wide. Messages
+    //! exceeding the budget are dropped by level: trace messages are dropped
+    //! first, then debug and info messages. Warnings and errors are always
+    //! logged, but consume the budget as well. Levels that are dropped are
+    //! shed by the level checks of the statements until the budget was
+    //! refilled, thus their messages are not built. A message exceeding the
+    //! burst is admitted if the budget is full. While messages are dropped, a
+    //! summary of the dropped messages is logged as a warning periodically,
+    //! by `flush` and when the budget is replaced. A default constructed
+    //! budget disables the limit (default).
+    GT_LOGGING_EXPORT
+    void setBudget(LogBudget const& budget);
+
+    //! Returns the current budget
+    GT_LOGGING_EXPORT
+    LogBudget budget() const;
+
+    //! Returns the available tokens and the drop counters of the budget
+    GT_LOGGING_EXPORT
+    LogBudgetState budgetState() const;
+
+    //! Opens a binary log file (".gtlogb"). Binary logging statements
+    //! (`gtInfoB` etc.) are written to this file without being formatted
+    //! instead of being sent to the destinations. The file may be rendered
+    //! using `gtlog-decode` or `readBinaryLog`. The file is written by a
+    //! writer thread in blocks. An open file is replaced. Returns false if
+    //! the file cannot be opened.
+    GT_LOGGING_EXPORT
+    bool openBinaryLog(std::string const& filePath);
+
+    //! Closes the binary log file. Binary logging statements are sent to the
+    //! destinations again.
+    GT_LOGGING_EXPORT
+    void closeBinaryLog();
+
+    //! Returns whether a binary log file is open
+    GT_LOGGING_EXPORT
+    bool isBinaryLogOpen() const;
+
+    //! Prepares the calling thread for real-time logging statements
+    //! (`gtInfoRt` etc.) by preallocating its records. Must be called before
+    //! the thread enters its real-time section, as real-time statements of
+    //! threads that are not prepared are dropped. Calling it again replaces
+    //! the records. Returns false if locking the records into memory was
+    //! requested but failed (the records are usable nonetheless).
+    GT_LOGGING_EXPORT
+    bool prepareRealtimeThread(RealtimeOptions const& options = {});
+
+    //! Releases the records of the calling thread once they were written.
+    //! Called automatically when the thread exits.
+    GT_LOGGING_EXPORT
+    void releaseRealtimeThread();
+
+    //! Returns the drop counters of the real-time logging statements
+    GT_LOGGING_EXPORT
+    RealtimeStats realtimeStats() const;
+
+    //! Installs handlers for crash signals (SIGSEGV, SIGABRT, SIGBUS, SIGFPE
+    //! and SIGILL). Once a signal is raised, an emergency message is written
+    //! and messages that are still pending (e.g. queued in asynchronous mode)
+    //! are flushed by a helper thread, waiting at most the flush timeout.
+    //! The signal is then passed on to the previous handler. Returns false if
+    //! not supported by the platform.
+    GT_LOGGING_EXPORT
+    bool installCrashHandler(CrashHandlerOptions const& options = {});
+
+    //! Restores the signal handlers replaced by `installCrashHandler`
+    GT_LOGGING_EXPORT
+    void removeCrashHandler();
+
+    //! Formats the encoded arguments of a binary logging statement and sends
+    //! the message to all destinations. In asynchronous mode the message is
+    //! formatted on the backend thread.
+    GT_LOGGING_EXPORT
+    void logBinary(Level level, std::uint32_t format,
+                   char const* data, std::size_t size, std::time_t time,
+                   ThreadInfo const& thread);
+
     //! The helper forwards the streaming to QDebug and builds the final
     //! log message.
     class Helper
@@ -148,7 +477,16 @@ public:
 
         explicit Helper(Level _level, std::string _id = GT_MODULE_ID) :
             level{_level},
-            id{std::move(_id)}
+            id{std::move(_id)},
+            gtStream{_level}
+        {}
+
+        Helper(Level _level, SourceLocation _location,
+               std::string _id = GT_MODULE_ID) :
+            level{_level},
+            location{_location},
+            id{std::move(_id)},
+            gtStream{_level}
         {}
 
         ~Helper() { writeToLog(); }
@@ -157,6 +495,7 @@ public:
     private:
 
         Level level;
+        SourceLocation location;
         std::string id;
         Stream gtStream;
 
@@ -177,6 +516,36 @@ private:
     std::unique_ptr<Impl> pimpl;
 };
 
+namespace detail
+{
+
+//! Returns whether the level is above the compile time minimum level. Forces
+//! the check to be a constant expression
+template <int Level, int MinLevel>
+constexpr bool isLevelCompiledIn() noexcept { return Level >= MinLevel; }
+
+//! Inserts the hash into a cache that checks and inserts atomically
+template <typename Cache,
+          std::enable_if_t<std::is_same<decltype(std::declval<Cache&>()
+                                                 .insert(hash_t{})),
+                                        bool>::value, bool> = true>
+inline bool insertOnce(Cache& cache, hash_t hash, int)
+{
+    return cache.insert(hash);
+}
+
+//! Inserts the hash into a cache that provides `find` and `append` only
+template <typename Cache>
+inline bool insertOnce(Cache& cache, hash_t hash, long)
+{
+    if (cache.find(hash)) return false;
+
+    cache.append(hash);
+    return true;
+}
+
+} // namespace detail
+
 template <typename Cache>
 class LogOnce
 {
@@ -185,6 +554,16 @@ public:
     explicit LogOnce(Cache& _cache, Level _level, std::string _id = GT_MODULE_ID) :
         level{_level},
         id{std::move(_id)},
+        gtStream{_level},
+        cache(&_cache)
+    {}
+
+    LogOnce(Cache& _cache, Level _level, SourceLocation _location,
+            std::string _id = GT_MODULE_ID) :
+        level{_level},
+        location{_location},
+        id{std::move(_id)},
+        gtStream{_level},
         cache(&_cache)
     {}
 
@@ -193,16 +572,13 @@ public:
     {
         if (!gtStream.mayLog()) return;
 
-        std::string message = gtStream.str();
+        std::string const& message = gtStream.message();
         if (message.empty()) return;
 
         hash_t hash = gt::log::hash(message, id, level);
+        if (!detail::insertOnce(*cache, hash, 0)) return;
 
-        bool hashExists = cache->find(hash);
-        if (hashExists) return;
-
-        cache->append(hash);
-        Logger::instance().log(level, std::move(message), std::move(id));
+        Logger::instance().log(level, gtStream, id, location);
     }
 
     gt::log::Stream& stream() { return gtStream; }
@@ -210,6 +586,7 @@ public:
 private:
 
     Level level;
+    SourceLocation location;
     std::string id;
     Stream gtStream;
     Cache* cache;
@@ -228,6 +605,59 @@ inline auto logOnce(Level level, std::string id  = GT_MODULE_ID)
     return logOnce(Logger::instance().globalCache, level, std::move(id));
 }
 
+//! Same as above, passing the location of the logging statement
+template <typename Cache>
+inline auto logOnce(Cache& cache, Level level, SourceLocation location,
+                    std::string id = GT_MODULE_ID)
+{
+    return LogOnce<Cache>(cache, level, location, std::move(id));
+}
+
+inline auto logOnce(Level level, SourceLocation location,
+                    std::string id = GT_MODULE_ID)
+{
+    return logOnce(Logger::instance().globalCache, level, location,
+                   std::move(id));
+}
+
+namespace detail
+{
+
+template <typename Functor>
+struct LazyType
+{
+    Functor functor;
+};
+
+} // namespace detail
+
+/**
+ * @brief Allows to log the result of a functor, which is only called if the
+ * message will be written, i.e. if the logging statement passes the level
+ * and verbosity checks and at least one destination accepts its level.
+ * @param functor Functor returning the value to log
+ * @return Helper object to log the result of the functor
+ */
+template <typename Functor>
+inline detail::LazyType<std::decay_t<Functor>> lazy(Functor&& functor)
+{
+    return {std::forward<Functor>(functor)};
+}
+
+/// operator to log lazy values
+template <typename Functor>
+inline Stream&
+operator<<(Stream& s, detail::LazyType<Functor> const& l)
+{
+    if (!s.mayLog()) return s;
+
+    // streams that do not belong to a logging statement are always evaluated
+    Level level = s.level();
+    if (level != OffLevel && !Logger::instance().acceptsLevel(level)) return s;
+
+    return s << l.functor();
+}
+
 } // namespace log
 
 } // namespace gt
@@ -256,9 +686,42 @@ inline auto logOnce(Level level, std::string id  = GT_MODULE_ID)
 
 ////////// HELPER MACROS FOR COMON CODE //////////
 
-// log only if logging level matches
+// static descriptor of the logging statement, registered on first use
+#define GT_LOG_IMPL_CALL_SITE(LEVEL) \
+    ([]() -> gt::log::detail::CallSiteHandle& { \
+        static gt::log::detail::CallSiteHandle site{ \
+            __FILE__, __LINE__, gt::log::LEVEL, GT_MODULE_ID}; \
+        return site; \
+    }())
+
+// location of the logging statement, the directories of the file are
+// stripped at compile time
+#define GT_LOG_IMPL_SOURCE_LOCATION() \
+    gt::log::SourceLocation{ \
+        __FILE__ + std::integral_constant<std::size_t, \
+            gt::log::detail::fileNameOffset(__FILE__)>::value, \
+        __LINE__, __func__}
+
+// log only if logging level matches (compile time and runtime)
 #define GT_LOG_IMPL_IF_LEVEL(LEVEL) \
-if (gt::log::Logger::instance().loggingLevel() <= gt::log::LEVEL)
+if (gt::log::detail::isLevelCompiledIn<gt::log::LEVEL, (GT_LOG_MIN_LEVEL)>() && \
+    GT_LOG_IMPL_CALL_SITE(LEVEL).isEnabled())
+
+// same as above, but for module ids that are passed explicitly
+#define GT_LOG_IMPL_IF_LEVEL_ID(LEVEL, ID) \
+if (gt::log::detail::isLevelCompiledIn<gt::log::LEVEL, (GT_LOG_MIN_LEVEL)>() && \
+    GT_LOG_IMPL_CALL_SITE(LEVEL).isEnabled(ID))
+
+// same as above, but checks the verbosity level first
+#define GT_LOG_IMPL_IF_LEVEL_V(LEVEL, V) \
+if (gt::log::detail::isLevelCompiledIn<gt::log::LEVEL, (GT_LOG_MIN_LEVEL)>() && \
+    gt::log::detail::isVerbosityEnabled(V) && \
+    GT_LOG_IMPL_CALL_SITE(LEVEL).isEnabled())
+
+#define GT_LOG_IMPL_IF_LEVEL_ID_V(LEVEL, ID, V) \
+if (gt::log::detail::isLevelCompiledIn<gt::log::LEVEL, (GT_LOG_MIN_LEVEL)>() && \
+    gt::log::detail::isVerbosityEnabled(V) && \
+    GT_LOG_IMPL_CALL_SITE(LEVEL).isEnabled(ID))
 
 // apply global flags (quote, nospace, line numbers)
 #define GT_LOG_IMPL_APPLY_FLAGS() \
@@ -270,7 +733,8 @@ if (gt::log::Logger::instance().loggingLevel() <= gt::log::LEVEL)
 
 #define GT_LOG_IMPL_MESSAGE(LEVEL) \
     GT_LOG_IMPL_IF_LEVEL(LEVEL) \
-        gt::log::Logger::Helper(gt::log::LEVEL).stream() \
+        gt::log::Logger::Helper(gt::log::LEVEL, \
+                                GT_LOG_IMPL_SOURCE_LOCATION()).stream() \
             GT_LOG_IMPL_APPLY_FLAGS()
 
 //! Default logging macros
@@ -284,8 +748,9 @@ if (gt::log::Logger::instance().loggingLevel() <= gt::log::LEVEL)
 ////////// DEFAULT LOGGING MACROS WITH ID //////////
 
 #define GT_LOG_IMPL_MEESAGE_ID(LEVEL, ID) \
-    GT_LOG_IMPL_IF_LEVEL(LEVEL) \
-        gt::log::Logger::Helper(gt::log::LEVEL, ID).stream() \
+    GT_LOG_IMPL_IF_LEVEL_ID(LEVEL, ID) \
+        gt::log::Logger::Helper(gt::log::LEVEL, \
+                                GT_LOG_IMPL_SOURCE_LOCATION(), ID).stream() \
             GT_LOG_IMPL_APPLY_FLAGS()
 
 #define gtTraceId(ID)   GT_LOG_IMPL_MEESAGE_ID(TraceLevel, ID)
@@ -295,15 +760,166 @@ if (gt::log::Logger::instance().loggingLevel() <= gt::log::LEVEL)
 #define gtErrorId(ID)   GT_LOG_IMPL_MEESAGE_ID(ErrorLevel, ID)
 #define gtFatalId(ID)   GT_LOG_IMPL_MEESAGE_ID(FatalLevel, ID)
 
+////////// VERBOSE LOGGING MACROS //////////
+
+// the verbosity is checked before the stream is created, thus the arguments
+// of suppressed messages are not evaluated
+#define GT_LOG_IMPL_MESSAGE_V(LEVEL, V) \
+    GT_LOG_IMPL_IF_LEVEL_V(LEVEL, V) \
+        gt::log::Logger::Helper(gt::log::LEVEL, \
+                                GT_LOG_IMPL_SOURCE_LOCATION()).stream() \
+            .verbose(V) GT_LOG_IMPL_APPLY_FLAGS()
+
+#define gtTraceV(V)     GT_LOG_IMPL_MESSAGE_V(TraceLevel, V)
+#define gtDebugV(V)     GT_LOG_IMPL_MESSAGE_V(DebugLevel, V)
+#define gtInfoV(V)      GT_LOG_IMPL_MESSAGE_V(InfoLevel, V)
+#define gtWarningV(V)   GT_LOG_IMPL_MESSAGE_V(WarningLevel, V)
+#define gtErrorV(V)     GT_LOG_IMPL_MESSAGE_V(ErrorLevel, V)
+#define gtFatalV(V)     GT_LOG_IMPL_MESSAGE_V(FatalLevel, V)
+
+#define GT_LOG_IMPL_MESSAGE_ID_V(LEVEL, ID, V) \
+    GT_LOG_IMPL_IF_LEVEL_ID_V(LEVEL, ID, V) \
+        gt::log::Logger::Helper(gt::log::LEVEL, \
+                                GT_LOG_IMPL_SOURCE_LOCATION(), ID).stream() \
+            .verbose(V) GT_LOG_IMPL_APPLY_FLAGS()
+
+#define gtTraceIdV(ID, V)   GT_LOG_IMPL_MESSAGE_ID_V(TraceLevel, ID, V)
+#define gtDebugIdV(ID, V)   GT_LOG_IMPL_MESSAGE_ID_V(DebugLevel, ID, V)
+#define gtInfoIdV(ID, V)    GT_LOG_IMPL_MESSAGE_ID_V(InfoLevel, ID, V)
+#define gtWarningIdV(ID, V) GT_LOG_IMPL_MESSAGE_ID_V(WarningLevel, ID, V)
+#define gtErrorIdV(ID, V)   GT_LOG_IMPL_MESSAGE_ID_V(ErrorLevel, ID, V)
+#define gtFatalIdV(ID, V)   GT_LOG_IMPL_MESSAGE_ID_V(FatalLevel, ID, V)
+
+////////// FORMAT STRING MACROS //////////
+
+// wraps the format string into a type, such that it can be validated at
+// compile time together with the types of the arguments
+#define GT_LOG_IMPL_FORMAT_STRING(FMT) \
+    ([]() { \
+        struct GtLogFormatString { \
+            static constexpr char const* value() { return FMT; } \
+        }; \
+        return GtLogFormatString{}; \
+    }())
+
+// extracts the format string, which is the first argument
+#define GT_LOG_IMPL_FORMAT_FIRST(FMT, ...) FMT
+#define GT_LOG_IMPL_FORMAT_RECOMPOSER(ArgsWithBrackets) GT_LOG_IMPL_FORMAT_FIRST ArgsWithBrackets
+#define GT_LOG_IMPL_FORMAT_FMT(...) GT_LOG_IMPL_FORMAT_RECOMPOSER((__VA_ARGS__, ))
+
+// arguments are evaluated only if the message is logged
+#define GT_LOG_IMPL_MESSAGE_F(LEVEL, ...) \
+    GT_LOG_IMPL_IF_LEVEL(LEVEL) \
+        gt::log::detail::formatMessage( \
+            gt::log::Logger::Helper(gt::log::LEVEL, \
+                                    GT_LOG_IMPL_SOURCE_LOCATION()).stream() \
+                GT_LOG_IMPL_APPLY_FLAGS(), \
+            GT_LOG_IMPL_FORMAT_STRING(GT_LOG_IMPL_FORMAT_FMT(__VA_ARGS__)), \
+            __VA_ARGS__)
+
+//! Logging macros using a format string, e.g. gtInfoF("x={} y={}", x, y)
+#define gtTraceF(...)   GT_LOG_IMPL_MESSAGE_F(TraceLevel, __VA_ARGS__)
+#define gtDebugF(...)   GT_LOG_IMPL_MESSAGE_F(DebugLevel, __VA_ARGS__)
+#define gtInfoF(...)    GT_LOG_IMPL_MESSAGE_F(InfoLevel, __VA_ARGS__)
+#define gtWarningF(...) GT_LOG_IMPL_MESSAGE_F(WarningLevel, __VA_ARGS__)
+#define gtErrorF(...)   GT_LOG_IMPL_MESSAGE_F(ErrorLevel, __VA_ARGS__)
+#define gtFatalF(...)   GT_LOG_IMPL_MESSAGE_F(FatalLevel, __VA_ARGS__)
+
+#define GT_LOG_IMPL_MESSAGE_ID_F(LEVEL, ID, ...) \
+    GT_LOG_IMPL_IF_LEVEL_ID(LEVEL, ID) \
+        gt::log::detail::formatMessage( \
+            gt::log::Logger::Helper(gt::log::LEVEL, \
+                                    GT_LOG_IMPL_SOURCE_LOCATION(), ID).stream() \
+                GT_LOG_IMPL_APPLY_FLAGS(), \
+            GT_LOG_IMPL_FORMAT_STRING(GT_LOG_IMPL_FORMAT_FMT(__VA_ARGS__)), \
+            __VA_ARGS__)
+
+#define gtTraceIdF(ID, ...)   GT_LOG_IMPL_MESSAGE_ID_F(TraceLevel, ID, __VA_ARGS__)
+#define gtDebugIdF(ID, ...)   GT_LOG_IMPL_MESSAGE_ID_F(DebugLevel, ID, __VA_ARGS__)
+#define gtInfoIdF(ID, ...)    GT_LOG_IMPL_MESSAGE_ID_F(InfoLevel, ID, __VA_ARGS__)
+#define gtWarningIdF(ID, ...) GT_LOG_IMPL_MESSAGE_ID_F(WarningLevel, ID, __VA_ARGS__)
+#define gtErrorIdF(ID, ...)   GT_LOG_IMPL_MESSAGE_ID_F(ErrorLevel, ID, __VA_ARGS__)
+#define gtFatalIdF(ID, ...)   GT_LOG_IMPL_MESSAGE_ID_F(FatalLevel, ID, __VA_ARGS__)
+
+////////// BINARY LOGGING MACROS //////////
+
+// static description of the binary logging statement
+#define GT_LOG_IMPL_BINARY_FORMAT(LEVEL, FMT) \
+    ([]() -> gt::log::detail::BinaryFormatHandle& { \
+        static gt::log::detail::BinaryFormatHandle format{ \
+            FMT, __FILE__, __LINE__, gt::log::LEVEL, GT_MODULE_ID}; \
+        return format; \
+    }())
+
+// only the format id and the raw arguments are captured, formatting is
+// deferred to the backend thread or to the decoder of the binary log file
+#define GT_LOG_IMPL_MESSAGE_B(LEVEL, ...) \
+    GT_LOG_IMPL_IF_LEVEL(LEVEL) \
+        gt::log::detail::logBinary( \
+            GT_LOG_IMPL_BINARY_FORMAT(LEVEL, GT_LOG_IMPL_FORMAT_FMT(__VA_ARGS__)), \
+            GT_LOG_IMPL_FORMAT_STRING(GT_LOG_IMPL_FORMAT_FMT(__VA_ARGS__)), \
+            __VA_ARGS__)
+
+//! Binary logging macros, e.g. gtInfoB("iteration {} residual {:.3e}", i, r)
+#define gtTraceB(...)   GT_LOG_IMPL_MESSAGE_B(TraceLevel, __VA_ARGS__)
+#define gtDebugB(...)   GT_LOG_IMPL_MESSAGE_B(DebugLevel, __VA_ARGS__)
+#define gtInfoB(...)    GT_LOG_IMPL_MESSAGE_B(InfoLevel, __VA_ARGS__)
+#define gtWarningB(...) GT_LOG_IMPL_MESSAGE_B(WarningLevel, __VA_ARGS__)
+#define gtErrorB(...)   GT_LOG_IMPL_MESSAGE_B(ErrorLevel, __VA_ARGS__)
+#define gtFatalB(...)   GT_LOG_IMPL_MESSAGE_B(FatalLevel, __VA_ARGS__)
+
+////////// REAL-TIME LOGGING MACROS //////////
+
+// statements are not registered as call sites (which allocates), thus only
+// the global logging level applies
+#define GT_LOG_IMPL_IF_LEVEL_RT(LEVEL) \
+if (gt::log::detail::isLevelCompiledIn<gt::log::LEVEL, (GT_LOG_MIN_LEVEL)>() && \
+    gt::log::detail::isLevelEnabled(gt::log::LEVEL))
+
+// unique type per statement providing its static description, so that its
+// format id is registered while the module is loaded
+#define GT_LOG_IMPL_REALTIME_FORMAT(LEVEL, FMT) \
+    ([]() { \
+        struct Site \
+        { \
+            static gt::log::detail::BinaryFormatHandle& handle() \
+            { \
+                static gt::log::detail::BinaryFormatHandle format{ \
+                    FMT, __FILE__, __LINE__, gt::log::LEVEL, GT_MODULE_ID}; \
+                return format; \
+            } \
+        }; \
+        return Site{}; \
+    }())
+
+// the arguments are copied into a preallocated record of the calling thread
+#define GT_LOG_IMPL_MESSAGE_RT(LEVEL, ...) \
+    GT_LOG_IMPL_IF_LEVEL_RT(LEVEL) \
+        gt::log::detail::logRealtime( \
+            GT_LOG_IMPL_REALTIME_FORMAT(LEVEL, GT_LOG_IMPL_FORMAT_FMT(__VA_ARGS__)), \
+            GT_LOG_IMPL_FORMAT_STRING(GT_LOG_IMPL_FORMAT_FMT(__VA_ARGS__)), \
+            __VA_ARGS__)
+
+//! Real-time logging macros. Never block, allocate or call into the system on
+//! threads prepared by `Logger::prepareRealtimeThread`.
+#define gtTraceRt(...)   GT_LOG_IMPL_MESSAGE_RT(TraceLevel, __VA_ARGS__)
+#define gtDebugRt(...)   GT_LOG_IMPL_MESSAGE_RT(DebugLevel, __VA_ARGS__)
+#define gtInfoRt(...)    GT_LOG_IMPL_MESSAGE_RT(InfoLevel, __VA_ARGS__)
+#define gtWarningRt(...) GT_LOG_IMPL_MESSAGE_RT(WarningLevel, __VA_ARGS__)
+#define gtErrorRt(...)   GT_LOG_IMPL_MESSAGE_RT(ErrorLevel, __VA_ARGS__)
+#define gtFatalRt(...)   GT_LOG_IMPL_MESSAGE_RT(FatalLevel, __VA_ARGS__)
+
 ////////// LOG ONCE MACRO //////////
 
 #define GT_LOG_IMPL_ONCE_F1(LEVEL, ...) \
     GT_LOG_IMPL_IF_LEVEL(LEVEL ## Level) \
-        gt::log::logOnce(gt::log::LEVEL ## Level).stream() \
+        gt::log::logOnce(gt::log::LEVEL ## Level, \
+                         GT_LOG_IMPL_SOURCE_LOCATION()).stream() \
             GT_LOG_IMPL_APPLY_FLAGS()
 #define GT_LOG_IMPL_ONCE_F2(LEVEL, CACHE, ...) \
     GT_LOG_IMPL_IF_LEVEL(LEVEL ## Level) \
-        gt::log::logOnce(CACHE, gt::log::LEVEL ## Level).stream() \
+        gt::log::logOnce(CACHE, gt::log::LEVEL ## Level, \
+                         GT_LOG_IMPL_SOURCE_LOCATION()).stream() \
             GT_LOG_IMPL_APPLY_FLAGS()
 
 // variadic macro magic
@@ -317,12 +933,14 @@ if (gt::log::Logger::instance().loggingLevel() <= gt::log::LEVEL)
 ////////// LOG ONCE WITH ID MACRO //////////
 
 #define GT_LOG_IMPL_ONCE_ID_F2(LEVEL, ID, ...) \
-    GT_LOG_IMPL_IF_LEVEL(LEVEL ## Level) \
-        gt::log::logOnce(gt::log::LEVEL ## Level, ID).stream() \
+    GT_LOG_IMPL_IF_LEVEL_ID(LEVEL ## Level, ID) \
+        gt::log::logOnce(gt::log::LEVEL ## Level, \
+                         GT_LOG_IMPL_SOURCE_LOCATION(), ID).stream() \
             GT_LOG_IMPL_APPLY_FLAGS()
 #define GT_LOG_IMPL_ONCE_ID_F3(LEVEL, ID, CACHE, ...) \
-    GT_LOG_IMPL_IF_LEVEL(LEVEL ## Level) \
-        gt::log::logOnce(CACHE, gt::log::LEVEL ## Level, ID).stream() \
+    GT_LOG_IMPL_IF_LEVEL_ID(LEVEL ## Level, ID) \
+        gt::log::logOnce(CACHE, gt::log::LEVEL ## Level, \
+                         GT_LOG_IMPL_SOURCE_LOCATION(), ID).stream() \
             GT_LOG_IMPL_APPLY_FLAGS()
 
 // variadic macro magic
@@ -333,6 +951,114 @@ if (gt::log::Logger::instance().loggingLevel() <= gt::log::LEVEL)
 
 #define gtLogOnceId(...) GT_LOG_IMPL_ONCE_ID_MACRO_CHOOSER( __VA_ARGS__)( __VA_ARGS__)
 
+////////// LOG ONCE PER CALL SITE MACRO //////////
+
+// static flag of the statement, set once it has been logged
+#define GT_LOG_IMPL_ONCE_SITE_FLAG() \
+    ([]() -> std::atomic<bool>& { \
+        static std::atomic<bool> logged{false}; \
+        return logged; \
+    }())
+
+#define GT_LOG_IMPL_ONCE_SITE(LEVEL) \
+    if (gt::log::detail::isLevelCompiledIn<gt::log::LEVEL ## Level, \
+                                           (GT_LOG_MIN_LEVEL)>() && \
+        gt::log::detail::isFirstAtSite(GT_LOG_IMPL_ONCE_SITE_FLAG(), \
+                                       GT_LOG_IMPL_CALL_SITE(LEVEL ## Level))) \
+        gt::log::Logger::Helper(gt::log::LEVEL ## Level, \
+                                GT_LOG_IMPL_SOURCE_LOCATION()).stream() \
+            GT_LOG_IMPL_APPLY_FLAGS()
+
+#define GT_LOG_IMPL_ONCE_SITE_ID(LEVEL, ID) \
+    if (gt::log::detail::isLevelCompiledIn<gt::log::LEVEL ## Level, \
+                                           (GT_LOG_MIN_LEVEL)>() && \
+        gt::log::detail::isFirstAtSite(GT_LOG_IMPL_ONCE_SITE_FLAG(), \
+                                       GT_LOG_IMPL_CALL_SITE(LEVEL ## Level), \
+                                       ID)) \
+        gt::log::Logger::Helper(gt::log::LEVEL ## Level, \
+                                GT_LOG_IMPL_SOURCE_LOCATION(), ID).stream() \
+            GT_LOG_IMPL_APPLY_FLAGS()
+
+//! Logs the first enabled execution of the statement only, regardless of the
+//! message. Subsequent executions skip the statement without constructing a
+//! stream or evaluating the arguments.
+#define gtLogOnceSite(LEVEL)       GT_LOG_IMPL_ONCE_SITE(LEVEL)
+#define gtLogOnceSiteId(LEVEL, ID) GT_LOG_IMPL_ONCE_SITE_ID(LEVEL, ID)
+
+////////// RATE LIMITED MACROS //////////
+
+// static state of the statement
+#define GT_LOG_IMPL_RATE_LIMIT() \
+    ([]() -> gt::log::detail::RateLimit& { \
+        static gt::log::detail::RateLimit limit; \
+        return limit; \
+    }())
+
+#define GT_LOG_IMPL_RATE(LEVEL, CHECK, N) \
+    if (gt::log::detail::RateLimit* gt_log_limit = \
+            gt::log::detail::isLevelCompiledIn<gt::log::LEVEL, \
+                                               (GT_LOG_MIN_LEVEL)>() ? \
+            gt::log::detail::CHECK(GT_LOG_IMPL_RATE_LIMIT(), \
+                                   GT_LOG_IMPL_CALL_SITE(LEVEL), (N)) : \
+            nullptr) \
+        gt::log::Logger::Helper(gt::log::LEVEL, \
+                                GT_LOG_IMPL_SOURCE_LOCATION()).stream() \
+            GT_LOG_IMPL_APPLY_FLAGS() \
+            << gt::log::detail::takeSuppressed(*gt_log_limit)
+
+//! Logs every N-th enabled execution of the statement, starting with the
+//! first one. Throttled executions skip the statement without constructing a
+//! stream or evaluating the arguments. Logged messages carry the number of
+//! suppressed executions as the field "suppressed".
+#define gtTraceEveryN(N)    GT_LOG_IMPL_RATE(TraceLevel, logEveryN, N)
+#define gtDebugEveryN(N)    GT_LOG_IMPL_RATE(DebugLevel, logEveryN, N)
+#define gtInfoEveryN(N)     GT_LOG_IMPL_RATE(InfoLevel, logEveryN, N)
+#define gtWarningEveryN(N)  GT_LOG_IMPL_RATE(WarningLevel, logEveryN, N)
+#define gtErrorEveryN(N)    GT_LOG_IMPL_RATE(ErrorLevel, logEveryN, N)
+#define gtFatalEveryN(N)    GT_LOG_IMPL_RATE(FatalLevel, logEveryN, N)
+
+//! Logs an enabled execution of the statement at most once every MS
+//! milliseconds. Logged messages carry the number of executions suppressed
+//! in the meantime as the field "suppressed".
+#define gtTraceEveryMs(MS)    GT_LOG_IMPL_RATE(TraceLevel, logEveryMs, MS)
+#define gtDebugEveryMs(MS)    GT_LOG_IMPL_RATE(DebugLevel, logEveryMs, MS)
+#define gtInfoEveryMs(MS)     GT_LOG_IMPL_RATE(InfoLevel, logEveryMs, MS)
+#define gtWarningEveryMs(MS)  GT_LOG_IMPL_RATE(WarningLevel, logEveryMs, MS)
+#define gtErrorEveryMs(MS)    GT_LOG_IMPL_RATE(ErrorLevel, logEveryMs, MS)
+#define gtFatalEveryMs(MS)    GT_LOG_IMPL_RATE(FatalLevel, logEveryMs, MS)
+
+//! Logs the first N enabled executions of the statement only
+#define gtTraceFirstN(N)    GT_LOG_IMPL_RATE(TraceLevel, logFirstN, N)
+#define gtDebugFirstN(N)    GT_LOG_IMPL_RATE(DebugLevel, logFirstN, N)
+#define gtInfoFirstN(N)     GT_LOG_IMPL_RATE(InfoLevel, logFirstN, N)
+#define gtWarningFirstN(N)  GT_LOG_IMPL_RATE(WarningLevel, logFirstN, N)
+#define gtErrorFirstN(N)    GT_LOG_IMPL_RATE(ErrorLevel, logFirstN, N)
+#define gtFatalFirstN(N)    GT_LOG_IMPL_RATE(FatalLevel, logFirstN, N)
+
+////////// SAMPLED MACROS //////////
+
+#define GT_LOG_IMPL_SAMPLED(LEVEL, RATE) \
+    if (double gt_log_weight = \
+            gt::log::detail::isLevelCompiledIn<gt::log::LEVEL, \
+                                               (GT_LOG_MIN_LEVEL)>() ? \
+            gt::log::detail::sample(GT_LOG_IMPL_CALL_SITE(LEVEL), (RATE)) : \
+            0.0) \
+        gt::log::Logger::Helper(gt::log::LEVEL, \
+                                GT_LOG_IMPL_SOURCE_LOCATION()).stream() \
+            GT_LOG_IMPL_APPLY_FLAGS() \
+            << gt::log::field("sample_weight", gt_log_weight)
+
+//! Logs a random fraction of the enabled executions of the statement, given
+//! by RATE in [0, 1]. Rates may be overridden per module at runtime using
+//! `Logger::setModuleSamplingRate`. Logged messages carry their sampling
+//! weight (1 / RATE) as the field "sample_weight".
+#define gtTraceSampled(RATE)    GT_LOG_IMPL_SAMPLED(TraceLevel, RATE)
+#define gtDebugSampled(RATE)    GT_LOG_IMPL_SAMPLED(DebugLevel, RATE)
+#define gtInfoSampled(RATE)     GT_LOG_IMPL_SAMPLED(InfoLevel, RATE)
+#define gtWarningSampled(RATE)  GT_LOG_IMPL_SAMPLED(WarningLevel, RATE)
+#define gtErrorSampled(RATE)    GT_LOG_IMPL_SAMPLED(ErrorLevel, RATE)
+#define gtFatalSampled(RATE)    GT_LOG_IMPL_SAMPLED(FatalLevel, RATE)
+
 ////////// APPLY GLOBAL DEFINES //////////
 
 #ifdef GT_LOG_DISABLE
@@ -139,6 +139,13 @@ template<typename T,
          detail::if_has_qdebug_shiftop<T> = true>
 inline Stream& operator<<(Stream& s, T const& t) { return detail::doLogQt(s, t); }
 
+//! Sets the name of the calling thread, e.g. `setThreadName(objectName())`
+//! in `QThread::run`
+inline void setThreadName(QString const& name)
+{
+    setThreadName(name.toStdString());
+}
+
 } // namespace log
 
 } // namespace gt
@@ -7,12 +7,15 @@
 #ifdef WIN32
   #ifdef GT_LOGGING_DLL
     #define GT_LOGGING_EXPORT __declspec (dllexport)
+    #define GT_LOGGING_DATA_EXPORT __declspec (dllexport)
   #else
     #define GT_LOGGING_EXPORT
+    // global variables must be imported explicitly
+    #define GT_LOGGING_DATA_EXPORT __declspec (dllimport)
   #endif
 #else
     #define GT_LOGGING_EXPORT
+    #define GT_LOGGING_DATA_EXPORT
 #endif
 
 #endif // GT_LOGGING_EXPORTS_H
-
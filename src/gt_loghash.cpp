@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_loghash.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace gt;
+
+namespace
+{
+
+constexpr std::uint64_t Prime1 = 11400714785074694791ull;
+constexpr std::uint64_t Prime2 = 14029467366897019727ull;
+constexpr std::uint64_t Prime3 =  1609587929392839161ull;
+constexpr std::uint64_t Prime4 =  9650029242287828579ull;
+constexpr std::uint64_t Prime5 =  2870177450012600261ull;
+
+inline std::uint64_t
+rotl(std::uint64_t x, int r) noexcept
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+//! Reads little endian values independently of the platform
+inline std::uint64_t
+read64(unsigned char const* p) noexcept
+{
+    std::uint64_t v = 0;
+    for (int i = 7; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+inline std::uint64_t
+read32(unsigned char const* p) noexcept
+{
+    std::uint64_t v = 0;
+    for (int i = 3; i >= 0; --i) v = (v << 8) | p[i];
+    return v;
+}
+
+inline std::uint64_t
+mixRound(std::uint64_t acc, std::uint64_t input) noexcept
+{
+    acc += input * Prime2;
+    acc = rotl(acc, 31);
+    return acc * Prime1;
+}
+
+inline std::uint64_t
+mergeRound(std::uint64_t acc, std::uint64_t value) noexcept
+{
+    acc ^= mixRound(0, value);
+    return acc * Prime1 + Prime4;
+}
+
+//! Consumes a 32 byte stripe
+inline void
+consume(std::uint64_t (&acc)[4], unsigned char const* p) noexcept
+{
+    for (int i = 0; i < 4; ++i) acc[i] = mixRound(acc[i], read64(p + 8 * i));
+}
+
+} // namespace
+
+log::detail::Hasher::Hasher(std::uint64_t seed) noexcept :
+    m_acc{seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1},
+    m_seed(seed)
+{}
+
+void
+log::detail::Hasher::update(void const* data, std::size_t size) noexcept
+{
+    auto const* p = static_cast<unsigned char const*>(data);
+    auto const* end = p + size;
+    m_total += size;
+
+    // complete a partial stripe first
+    if (m_buffered > 0)
+    {
+        std::size_t n = std::min(size, sizeof(m_buffer) - m_buffered);
+        std::memcpy(m_buffer + m_buffered, p, n);
+        m_buffered += n;
+        p += n;
+        if (m_buffered < sizeof(m_buffer)) return;
+
+        consume(m_acc, m_buffer);
+        m_buffered = 0;
+    }
+
+    for (; end - p >= 32; p += 32) consume(m_acc, p);
+
+    m_buffered = static_cast<std::size_t>(end - p);
+    if (m_buffered > 0) std::memcpy(m_buffer, p, m_buffered);
+}
+
+void
+log::detail::Hasher::update(std::string const& s) noexcept
+{
+    update(static_cast<std::uint64_t>(s.size()));
+    update(s.data(), s.size());
+}
+
+void
+log::detail::Hasher::update(std::uint64_t value) noexcept
+{
+    unsigned char bytes[8];
+    for (auto& b : bytes)
+    {
+        b = static_cast<unsigned char>(value);
+        value >>= 8;
+    }
+    update(bytes, sizeof(bytes));
+}
+
+std::uint64_t
+log::detail::Hasher::digest() const noexcept
+{
+    std::uint64_t h;
+    if (m_total >= 32)
+    {
+        h = rotl(m_acc[0], 1) + rotl(m_acc[1], 7) +
+            rotl(m_acc[2], 12) + rotl(m_acc[3], 18);
+        for (std::uint64_t acc : m_acc) h = mergeRound(h, acc);
+    }
+    else
+    {
+        h = m_seed + Prime5;
+    }
+    h += m_total;
+
+    unsigned char const* p = m_buffer;
+    unsigned char const* end = m_buffer + m_buffered;
+    for (; end - p >= 8; p += 8)
+    {
+        h ^= mixRound(0, read64(p));
+        h = rotl(h, 27) * Prime1 + Prime4;
+    }
+    if (end - p >= 4)
+    {
+        h ^= read32(p) * Prime1;
+        h = rotl(h, 23) * Prime2 + Prime3;
+        p += 4;
+    }
+    for (; p != end; ++p)
+    {
+        h ^= *p * Prime5;
+        h = rotl(h, 11) * Prime1;
+    }
+
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+    return h;
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGHASH_H
+#define GT_LOGHASH_H
+
+#include "gt_logging_exports.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gt
+{
+
+namespace log
+{
+
+namespace detail
+{
+
+/**
+ * @brief Streaming 64-bit hash (XXH64). Data may be passed in arbitrary
+ * chunks, the digest equals the one of the concatenated data. Does not
+ * allocate.
+ */
+class GT_LOGGING_EXPORT Hasher
+{
+public:
+
+    explicit Hasher(std::uint64_t seed = 0) noexcept;
+
+    //! Appends the bytes to the hashed data
+    void update(void const* data, std::size_t size) noexcept;
+
+    //! Appends the size and the bytes of the string. Prefixing the size
+    //! keeps consecutive strings apart (e.g. "ab", "c" and "a", "bc").
+    void update(std::string const& s) noexcept;
+
+    //! Appends the integer (as 8 bytes little endian)
+    void update(std::uint64_t value) noexcept;
+
+    //! Returns the hash of the data appended so far
+    std::uint64_t digest() const noexcept;
+
+private:
+
+    std::uint64_t m_total{0};
+    std::uint64_t m_acc[4];
+    unsigned char m_buffer[32];
+    std::size_t m_buffered{0};
+    std::uint64_t m_seed;
+};
+
+} // namespace detail
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGHASH_H
@@ -74,3 +74,9 @@ log::levelToString(Level level)
 {
     return LevelToText(level);
 }
+
+char const*
+log::levelToText(Level level) noexcept
+{
+    return LevelToText(level);
+}
@@ -30,7 +30,11 @@
 
 #include "gt_logging_exports.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 #include <ctime>
 
 namespace gt
@@ -60,11 +64,171 @@ enum Verbosity
     Everything = 9
 };
 
+//! Location of a logging statement. The strings are static and must not be
+//! freed.
+struct SourceLocation
+{
+    /// name of the source file (without directories), empty if unknown
+    char const* file = "";
+    /// line of the statement, 0 if unknown
+    int line = 0;
+    /// name of the enclosing function, empty if unknown
+    char const* function = "";
+};
+
+namespace detail
+{
+
+//! Returns the offset of the file name in the path
+constexpr std::size_t fileNameOffset(char const* path) noexcept
+{
+    std::size_t offset = 0;
+    for (std::size_t i = 0; path[i] != '\0'; ++i)
+    {
+        if (path[i] == '/' || path[i] == '\\') offset = i + 1;
+    }
+    return offset;
+}
+
+} // namespace detail
+
+//! Identity of a thread
+struct ThreadInfo
+{
+    /// id assigned by the OS, 0 if unknown
+    std::uint64_t id = 0;
+    /// name set by `setThreadName` (static string), empty if unknown
+    char const* name = "";
+};
+
+namespace detail
+{
+
+//! Immutable entry of a diagnostic context. Shared by all records emitted
+//! while the entry is in scope.
+struct ContextNode
+{
+    std::string key;
+    std::string value;
+    /// enclosing entry, null if this entry is the outermost one
+    std::shared_ptr<ContextNode const> parent;
+};
+
+} // namespace detail
+
+//! Snapshot of the diagnostic context of a thread (see `ScopedContext`).
+//! Copies share the snapshot, thus copying never allocates.
+class Context
+{
+public:
+
+    Context() = default;
+    explicit Context(std::shared_ptr<detail::ContextNode const> node) :
+        m_node(std::move(node))
+    {}
+
+    //! Returns whether the context has no entries
+    bool empty() const { return !m_node; }
+
+    //! Returns the value of the innermost entry with the given key or null
+    std::string const* find(std::string const& key) const
+    {
+        for (auto* node = m_node.get(); node; node = node->parent.get())
+        {
+            if (node->key == key) return &node->value;
+        }
+        return nullptr;
+    }
+
+    //! Calls `func(key, value)` for each entry from the outermost to the
+    //! innermost one. Entries shadowed by an inner entry with the same key
+    //! are skipped.
+    template <typename Func>
+    void forEach(Func&& func) const
+    {
+        forEach(m_node.get(), func);
+    }
+
+    //! Returns the entries as space separated "key=value" pairs
+    std::string toString() const
+    {
+        std::string out;
+        forEach([&out](std::string const& key, std::string const& value){
+            if (!out.empty()) out += ' ';
+            out += key;
+            out += '=';
+            out += value;
+        });
+        return out;
+    }
+
+    //! Returns the innermost entry (null if empty)
+    std::shared_ptr<detail::ContextNode const> const& node() const
+    {
+        return m_node;
+    }
+
+private:
+
+    std::shared_ptr<detail::ContextNode const> m_node;
+
+    template <typename Func>
+    void forEach(detail::ContextNode const* node, Func& func) const
+    {
+        if (!node) return;
+
+        forEach(node->parent.get(), func);
+        if (find(node->key) == &node->value) func(node->key, node->value);
+    }
+};
+
+//! Typed key/value pair of a log record (see `field`). Fields are carried
+//! alongside the message and are not part of its text.
+struct Field
+{
+    enum Type
+    {
+        Bool,
+        Int,
+        UInt,
+        Double,
+        String
+    };
+
+    union Number
+    {
+        bool b;
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+    };
+
+    std::string key;
+    Type type = String;
+    /// value of boolean and numeric fields
+    Number number = {};
+    /// value of string fields
+    std::string text;
+
+    //! Returns the value as text. Floating point values are formatted using
+    //! their shortest round trip representation.
+    GT_LOGGING_EXPORT
+    std::string valueToString() const;
+};
+
 //! Struct for message details
 struct Details
 {
     std::string id;
     std::tm time;
+    /// location of the logging statement
+    SourceLocation location = {};
+    /// thread of the logging statement
+    ThreadInfo thread = {};
+    /// diagnostic context of the thread (see `ScopedContext`)
+    Context context = {};
+    /// structured fields of the message (see `field`)
+    std::vector<Field> fields = {};
 };
 
 GT_LOGGING_EXPORT
@@ -73,6 +237,10 @@ Level levelFromString(std::string const& logMessage, bool* ok = {});
 GT_LOGGING_EXPORT
 std::string levelToString(Level level);
 
+//! Same as above without allocating, thus async-signal-safe
+GT_LOGGING_EXPORT
+char const* levelToText(Level level) noexcept;
+
 inline Level levelFromInt(int level)
 {
     return static_cast<Level>(level);
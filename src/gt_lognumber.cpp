@@ -0,0 +1,383 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Formatting of numbers without iostreams. The shortest representation of
+// floating point values is computed in gt_logryu.cpp.
+
+#include "gt_logstream.h"
+#include "gt_logryu.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace gt;
+
+namespace
+{
+
+/// up to this number of significant digits the shortest representation of
+/// a double can be rounded instead of the exact value
+constexpr int MaxRoundedDigits = 15;
+
+//! Decimal digits of a floating point value: d[0].d[1]d[2]... * 10^exponent.
+//! No digits denote zero.
+struct Digits
+{
+    char d[24];
+    int n = 0;
+    int exponent = 0;
+
+    explicit Digits(log::detail::Decimal decimal)
+    {
+        if (decimal.digits == 0) return;
+
+        n = log::detail::appendDigits(d, decimal.digits);
+        exponent = decimal.exponent + n - 1;
+    }
+
+    //! Returns the digit at the given power of ten
+    char at(int pos) const
+    {
+        int idx = exponent - pos;
+        return (idx >= 0 && idx < n) ? d[idx] : '0';
+    }
+
+    //! Rounds to the given number of significant digits. Returns false if
+    //! the digits are exactly halfway, as the exact binary value may be
+    //! above or below
+    bool round(int digits)
+    {
+        if (n <= digits) return true;
+        if (digits < 0)
+        {
+            n = 0;
+            return true;
+        }
+
+        char next = d[digits];
+        if (next == '5' && n == digits + 1) return false;
+
+        n = digits;
+        if (next < '5') return true;
+
+        int i = digits - 1;
+        while (i >= 0 && d[i] == '9') --i;
+        if (i >= 0)
+        {
+            d[i]++;
+            n = i + 1;
+            return true;
+        }
+        // carry into a new digit (e.g. 9.99 -> 10.0)
+        d[0] = '1';
+        n = 1;
+        ++exponent;
+        return true;
+    }
+
+    //! Removes trailing zeros
+    void trim()
+    {
+        while (n > 0 && d[n - 1] == '0') --n;
+    }
+};
+
+//! Returns whether the double is a subnormal number
+bool
+isSubnormal(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return ((bits >> 52) & 0x7ff) == 0 && (bits << 12) != 0;
+}
+
+//! Pads the number starting at `start` to the field width. Internal padding
+//! is inserted after the prefix (sign or base)
+void
+applyWidth(std::string& out, size_t start, size_t prefixEnd,
+           log::detail::NumberFormat const& format)
+{
+    size_t length = out.size() - start;
+    if (format.width <= 0 || static_cast<size_t>(format.width) <= length)
+    {
+        return;
+    }
+
+    size_t count = static_cast<size_t>(format.width) - length;
+    switch (format.flags & std::ios_base::adjustfield)
+    {
+    case std::ios_base::left:
+        out.append(count, format.fill);
+        break;
+    case std::ios_base::internal:
+        out.insert(prefixEnd, count, format.fill);
+        break;
+    default:
+        out.insert(start, count, format.fill);
+        break;
+    }
+}
+
+void
+appendFixed(std::string& out, Digits const& digits, int decimals,
+            bool showpoint)
+{
+    int top = (digits.n > 0 && digits.exponent > 0) ? digits.exponent : 0;
+    for (int pos = top; pos >= 0; --pos) out.push_back(digits.at(pos));
+
+    if (decimals > 0 || showpoint) out.push_back('.');
+    for (int pos = -1; pos >= -decimals; --pos) out.push_back(digits.at(pos));
+}
+
+void
+appendScientific(std::string& out, Digits const& digits, int decimals,
+                 bool showpoint, bool uppercase)
+{
+    out.push_back(digits.n > 0 ? digits.d[0] : '0');
+
+    if (decimals > 0 || showpoint) out.push_back('.');
+    for (int i = 1; i <= decimals; ++i)
+    {
+        out.push_back(i < digits.n ? digits.d[i] : '0');
+    }
+
+    int exponent = digits.n > 0 ? digits.exponent : 0;
+    out.push_back(uppercase ? 'E' : 'e');
+    out.push_back(exponent < 0 ? '-' : '+');
+    if (exponent < 0) exponent = -exponent;
+    if (exponent < 10) out.push_back('0');
+
+    char buffer[8];
+    out.append(buffer, static_cast<size_t>(
+                           log::detail::appendDigits(buffer, unsigned(exponent))));
+}
+
+//! Formats digits, which are either exact or already rounded to the
+//! precision. `significant` is the number of significant digits for the
+//! general format.
+void
+appendFloat(std::string& out, Digits& digits, bool negative, int decimals,
+            int significant, log::detail::NumberFormat const& format)
+{
+    auto flags = format.flags;
+    bool showpoint = flags & std::ios_base::showpoint;
+    bool uppercase = flags & std::ios_base::uppercase;
+
+    size_t start = out.size();
+    if (negative) out.push_back('-');
+    else if (flags & std::ios_base::showpos) out.push_back('+');
+    size_t prefixEnd = out.size();
+
+    switch (flags & std::ios_base::floatfield)
+    {
+    case std::ios_base::fixed:
+        appendFixed(out, digits, decimals, showpoint);
+        break;
+    case std::ios_base::scientific:
+        appendScientific(out, digits, decimals, showpoint, uppercase);
+        break;
+    default:
+    {
+        int exponent = digits.n > 0 ? digits.exponent : 0;
+        bool scientific = exponent < -4 || exponent >= significant;
+
+        if (!showpoint)
+        {
+            digits.trim();
+            decimals = scientific ? digits.n - 1 : digits.n - 1 - exponent;
+            if (decimals < 0) decimals = 0;
+        }
+        else
+        {
+            decimals = scientific ? significant - 1
+                                  : significant - 1 - exponent;
+        }
+
+        if (scientific)
+        {
+            appendScientific(out, digits, decimals, showpoint, uppercase);
+        }
+        else
+        {
+            appendFixed(out, digits, decimals, showpoint);
+        }
+        break;
+    }
+    }
+
+    applyWidth(out, start, prefixEnd, format);
+}
+
+//! Returns whether the value can be formatted without an ostream
+bool
+isSupported(double value, log::detail::NumberFormat const& format)
+{
+    auto floatfield = format.flags & std::ios_base::floatfield;
+    return value - value == 0 && // not inf or nan
+           format.precision >= 0 &&
+           floatfield != (std::ios_base::fixed | std::ios_base::scientific);
+}
+
+//! Formats the exact value of a double using the given precision
+bool
+appendRounded(std::string& out, double value,
+              log::detail::NumberFormat const& format)
+{
+    // the shortest representation cannot be rounded for subnormals, as the
+    // spacing of subnormals is too large relative to their value
+    if (isSubnormal(value)) return false;
+
+    Digits digits(log::detail::shortestDecimal(value));
+
+    int precision = static_cast<int>(format.precision);
+    int significant = 0;
+    switch (format.flags & std::ios_base::floatfield)
+    {
+    case std::ios_base::fixed:
+        significant = digits.exponent + 1 + precision;
+        break;
+    case std::ios_base::scientific:
+        significant = precision + 1;
+        break;
+    default:
+        // the C libraries differ in the number of trailing zeros after a
+        // carry (e.g. "%#.2g" of 99.9)
+        if (format.flags & std::ios_base::showpoint) return false;
+
+        significant = precision == 0 ? 1 : precision;
+        precision = significant;
+        break;
+    }
+
+    if (significant > MaxRoundedDigits) return false;
+    if (!digits.round(significant)) return false;
+
+    appendFloat(out, digits, std::signbit(value), precision, precision,
+                format);
+    return true;
+}
+
+//! Formats the shortest representation that reads back to the same value
+template <typename T>
+void
+appendShortest(std::string& out, T value, log::detail::NumberFormat const& format)
+{
+    Digits digits(log::detail::shortestDecimal(value));
+
+    int decimals = 0;
+    switch (format.flags & std::ios_base::floatfield)
+    {
+    case std::ios_base::fixed:
+        decimals = digits.n - 1 - digits.exponent;
+        if (decimals < 0) decimals = 0;
+        break;
+    case std::ios_base::scientific:
+        decimals = digits.n > 0 ? digits.n - 1 : 0;
+        break;
+    default:
+        break;
+    }
+
+    // use the same threshold for the scientific notation as for the
+    // precision of a double
+    appendFloat(out, digits, std::signbit(value), decimals,
+                std::numeric_limits<double>::max_digits10, format);
+}
+
+} // namespace
+
+bool
+log::detail::appendInteger(std::string& out,
+                           unsigned long long value,
+                           bool negative,
+                           bool isSigned,
+                           NumberFormat const& format)
+{
+    auto flags = format.flags;
+    auto basefield = flags & std::ios_base::basefield;
+
+    char buffer[32];
+    char* end = buffer + sizeof(buffer);
+    char* p = end;
+
+    char const* prefix = "";
+    if (basefield == std::ios_base::hex)
+    {
+        char const* hexDigits = (flags & std::ios_base::uppercase) ?
+                                    "0123456789ABCDEF" : "0123456789abcdef";
+        do
+        {
+            *--p = hexDigits[value & 0xf];
+            value >>= 4;
+        }
+        while (value != 0);
+
+        if ((flags & std::ios_base::showbase) && *p != '0')
+        {
+            prefix = (flags & std::ios_base::uppercase) ? "0X" : "0x";
+        }
+    }
+    else if (basefield == std::ios_base::oct)
+    {
+        do
+        {
+            *--p = static_cast<char>('0' + (value & 0x7));
+            value >>= 3;
+        }
+        while (value != 0);
+
+        // the leading zero is not treated as prefix for internal padding
+        if ((flags & std::ios_base::showbase) && *p != '0') *--p = '0';
+    }
+    else
+    {
+        // the sign of unsigned values depends on the standard library
+        if (!isSigned && (flags & std::ios_base::showpos)) return false;
+
+        p = buffer;
+        end = buffer + appendDigits(buffer, value);
+
+        if (negative) prefix = "-";
+        else if (flags & std::ios_base::showpos) prefix = "+";
+    }
+
+    size_t start = out.size();
+    out.append(prefix);
+    size_t prefixEnd = out.size();
+    out.append(p, static_cast<size_t>(end - p));
+
+    applyWidth(out, start, prefixEnd, format);
+    return true;
+}
+
+bool
+log::detail::appendFloatingPoint(std::string& out,
+                                 double value,
+                                 NumberFormat const& format)
+{
+    if (!isSupported(value, format)) return false;
+
+    if (format.roundtrip)
+    {
+        appendShortest(out, value, format);
+        return true;
+    }
+    return appendRounded(out, value, format);
+}
+
+bool
+log::detail::appendFloatingPoint(std::string& out,
+                                 float value,
+                                 NumberFormat const& format)
+{
+    if (!isSupported(value, format)) return false;
+
+    if (format.roundtrip)
+    {
+        appendShortest(out, value, format);
+        return true;
+    }
+    // iostreams format floats as doubles
+    return appendRounded(out, static_cast<double>(value), format);
+}
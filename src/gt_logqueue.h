@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGQUEUE_H
+#define GT_LOGQUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+namespace gt
+{
+
+namespace log
+{
+
+namespace detail
+{
+
+/**
+ * @brief Bounded lock-free multi-producer multi-consumer queue (based on the
+ * array queue of Dmitry Vyukov). The slots are allocated once and reused,
+ * thus elements are filled and consumed in place using functors, which allows
+ * to keep the capacity of members (e.g. strings) alive between messages.
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+
+    //! ctor. Capacity is rounded up to the next power of two (minimum 2)
+    explicit BoundedQueue(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+
+        m_mask = size - 1;
+        m_buffer = std::make_unique<Cell[]>(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(BoundedQueue const&) = delete;
+    BoundedQueue& operator=(BoundedQueue const&) = delete;
+
+    //! Returns the number of slots
+    size_t capacity() const noexcept { return m_mask + 1; }
+
+    //! Returns the number of slots that were claimed by producers so far
+    size_t enqueueCount() const noexcept
+    {
+        return m_enqueuePos.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Tries to claim a free slot and calls `fill(T&)` on it.
+     * @return Whether a slot was available
+     */
+    template <typename Fill>
+    bool tryPush(Fill&& fill)
+    {
+        Cell* cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_buffer[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // queue is full
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(cell->data);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Tries to dequeue the oldest element and calls `consume(T&)` on
+     * it. The slot is released once `consume` returns.
+     * @return Whether an element was available
+     */
+    template <typename Consume>
+    bool tryPop(Consume&& consume)
+    {
+        Cell* cell;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &m_buffer[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (m_dequeuePos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // queue is empty (or the next element is not published yet)
+                return false;
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        consume(cell->data);
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        T data{};
+    };
+
+    // padding to keep producer and consumer indices on separate cache lines
+    static constexpr size_t CacheLineSize = 64;
+
+    std::unique_ptr<Cell[]> m_buffer;
+    size_t m_mask{0};
+    char m_pad0[CacheLineSize];
+    std::atomic<size_t> m_enqueuePos{0};
+    char m_pad1[CacheLineSize - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_dequeuePos{0};
+    char m_pad2[CacheLineSize - sizeof(std::atomic<size_t>)];
+};
+
+} // namespace detail
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGQUEUE_H
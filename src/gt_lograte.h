@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGRATE_H
+#define GT_LOGRATE_H
+
+#include "gt_logcontrol.h"
+#include "gt_logfield.h"
+#include "gt_logstream.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace gt
+{
+
+namespace log
+{
+
+namespace detail
+{
+
+//! State of a rate limited logging statement. Constant initialized, thus
+//! statements do not need a guard for their static state.
+struct RateLimit
+{
+    /// number of enabled executions
+    std::atomic<std::uint64_t> count{0};
+    /// number of executions suppressed since the last message
+    std::atomic<std::uint64_t> suppressed{0};
+    /// earliest time of the next message (steady clock, milliseconds)
+    std::atomic<std::int64_t> next{0};
+};
+
+//! Number of suppressed executions, attached to a message as the field
+//! "suppressed" (if not zero)
+struct Suppressed
+{
+    std::uint64_t count;
+};
+
+inline Stream&
+operator<<(Stream& s, Suppressed suppressed)
+{
+    if (suppressed.count > 0) s << field("suppressed", suppressed.count);
+    return s;
+}
+
+//! Returns the number of executions suppressed since the last message and
+//! resets it
+inline Suppressed
+takeSuppressed(RateLimit& limit) noexcept
+{
+    return {limit.suppressed.exchange(0, std::memory_order_relaxed)};
+}
+
+//! Logs every n-th enabled execution of the statement, starting with the
+//! first one. Returns the state if the statement should be logged.
+inline RateLimit*
+logEveryN(RateLimit& limit, CallSiteHandle& site, std::uint64_t n)
+{
+    if (!site.isEnabled()) return nullptr;
+
+    std::uint64_t count = limit.count.fetch_add(1, std::memory_order_relaxed);
+    if (n <= 1 || count % n == 0) return &limit;
+
+    limit.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+//! Logs the first n enabled executions of the statement. Afterwards, the
+//! check is a single relaxed load.
+inline RateLimit*
+logFirstN(RateLimit& limit, CallSiteHandle& site, std::uint64_t n)
+{
+    if (limit.count.load(std::memory_order_relaxed) >= n) return nullptr;
+    if (!site.isEnabled()) return nullptr;
+
+    return limit.count.fetch_add(1, std::memory_order_relaxed) < n ?
+               &limit : nullptr;
+}
+
+//! Logs an enabled execution of the statement at most once per interval
+//! (in milliseconds)
+inline RateLimit*
+logEveryMs(RateLimit& limit, CallSiteHandle& site, std::int64_t interval)
+{
+    if (!site.isEnabled()) return nullptr;
+
+    using namespace std::chrono;
+    std::int64_t now = duration_cast<milliseconds>(
+        steady_clock::now().time_since_epoch()).count();
+
+    // a single thread claims the interval
+    std::int64_t next = limit.next.load(std::memory_order_relaxed);
+    if (now >= next &&
+        limit.next.compare_exchange_strong(next, now + interval,
+                                           std::memory_order_relaxed))
+    {
+        return &limit;
+    }
+
+    limit.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+} // namespace detail
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGRATE_H
@@ -0,0 +1,353 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logrealtime.h"
+#include "gt_logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+using namespace gt;
+
+using MutexLocker = const std::lock_guard<std::mutex>;
+
+namespace
+{
+
+static_assert(sizeof(log::detail::RealtimeSlot) <= 128,
+              "records should not exceed two cache lines");
+
+/// interval in which the backend thread polls the records, as producers
+/// must not wake it up
+constexpr std::chrono::milliseconds PollInterval{1};
+
+//! Records of a single thread. Single producer (the owning thread), single
+//! consumer (the backend thread).
+struct Ring
+{
+    explicit Ring(log::RealtimeOptions const& options)
+    {
+        std::size_t capacity = 1;
+        while (capacity < std::max<std::size_t>(options.capacity, 2))
+        {
+            capacity <<= 1;
+        }
+
+        slots.reset(new log::detail::RealtimeSlot[capacity]);
+        mask = capacity - 1;
+
+        // touch all pages, so that the producer does not fault them in
+        std::memset(static_cast<void*>(slots.get()), 0, bytes());
+    }
+
+    ~Ring()
+    {
+        if (locked) unlock();
+    }
+
+    std::size_t bytes() const
+    {
+        return (mask + 1) * sizeof(log::detail::RealtimeSlot);
+    }
+
+    bool lock()
+    {
+#ifdef _WIN32
+        locked = VirtualLock(slots.get(), bytes()) != 0;
+#else
+        locked = mlock(slots.get(), bytes()) == 0;
+#endif
+        return locked;
+    }
+
+    void unlock()
+    {
+#ifdef _WIN32
+        VirtualUnlock(slots.get(), bytes());
+#else
+        munlock(slots.get(), bytes());
+#endif
+    }
+
+    std::unique_ptr<log::detail::RealtimeSlot[]> slots;
+    std::size_t mask{0};
+    bool locked{false};
+    /// owning thread
+    log::ThreadInfo thread{log::currentThread()};
+
+    /// next record to read (written by the consumer)
+    alignas(64) std::atomic<std::size_t> head{0};
+    /// next record to write (written by the producer)
+    alignas(64) std::atomic<std::size_t> tail{0};
+    /// last known head, read by the producer only
+    std::size_t cachedHead{0};
+    /// number of dropped records
+    std::atomic<std::uint64_t> dropped{0};
+    /// whether the owning thread has released the ring
+    std::atomic<bool> released{false};
+};
+
+// trivially initialized, thus accessing it does not run any code
+thread_local Ring* currentRing = nullptr;
+
+//! Releases the ring once its thread exits
+struct RingHolder
+{
+    std::shared_ptr<Ring> ring;
+
+    ~RingHolder()
+    {
+        if (!ring) return;
+
+        // statements executed later during the thread's teardown (e.g. by
+        // destructors of other thread locals) must not use the ring, which
+        // may be freed by the backend once released
+        currentRing = nullptr;
+        ring->released.store(true, std::memory_order_release);
+    }
+};
+
+thread_local RingHolder ringHolder;
+
+//! Owns the rings of all threads and the backend thread draining them
+struct RealtimeRegistry
+{
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::condition_variable flushed;
+    std::vector<std::shared_ptr<Ring>> rings;
+    std::thread thread;
+    bool stopRequested{false};
+    /// drain cycles requested by `flush` and completed by the backend
+    std::uint64_t requested{0};
+    std::uint64_t completed{0};
+
+    /// counters of released rings
+    std::uint64_t dropped{0};
+    std::atomic<std::uint64_t> unprepared{0};
+
+    void add(std::shared_ptr<Ring> ring)
+    {
+        MutexLocker lock(mutex);
+        rings.push_back(std::move(ring));
+
+        if (!thread.joinable())
+        {
+            stopRequested = false;
+            thread = std::thread([this](){ run(); });
+        }
+    }
+
+    //! Writes all published records of the ring
+    static void drain(Ring& ring)
+    {
+        std::size_t head = ring.head.load(std::memory_order_relaxed);
+        std::size_t tail = ring.tail.load(std::memory_order_acquire);
+
+        for (; head != tail; ++head)
+        {
+            auto const& slot = ring.slots[head & ring.mask];
+            try
+            {
+                log::detail::writeBinary(slot.format, slot.level,
+                                         slot.data, slot.size,
+                                         static_cast<std::time_t>(slot.time),
+                                         ring.thread);
+            }
+            catch (std::exception const& e)
+            {
+                std::cerr << "GtLogging: exception in destination: "
+                          << e.what() << '\n';
+            }
+            catch (...)
+            {
+                std::cerr << "GtLogging: unknown exception in destination!\n";
+            }
+            ring.head.store(head + 1, std::memory_order_release);
+        }
+    }
+
+    //! Drains all rings and removes the released ones. The rings are
+    //! copied, so that threads may be prepared in the meantime.
+    void drainAll()
+    {
+        std::vector<std::shared_ptr<Ring>> current;
+        {
+            MutexLocker lock(mutex);
+            current = rings;
+        }
+
+        for (auto const& ring : current)
+        {
+            // check before draining, as records may be published until the
+            // ring is released
+            bool released = ring->released.load(std::memory_order_acquire);
+            drain(*ring);
+            if (!released) continue;
+
+            MutexLocker lock(mutex);
+            dropped += ring->dropped.load(std::memory_order_relaxed);
+            rings.erase(std::remove(rings.begin(), rings.end(), ring),
+                        rings.end());
+        }
+    }
+
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            std::uint64_t request = requested;
+            bool stop = stopRequested;
+
+            lock.unlock();
+            drainAll();
+            lock.lock();
+
+            completed = request;
+            flushed.notify_all();
+            if (stop) break;
+
+            wakeup.wait_for(lock, PollInterval, [this, request](){
+                return requested != request || stopRequested;
+            });
+        }
+    }
+
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!thread.joinable()) return;
+
+        std::uint64_t request = ++requested;
+        wakeup.notify_one();
+        flushed.wait(lock, [this, request](){ return completed >= request; });
+    }
+
+    void stop()
+    {
+        {
+            MutexLocker lock(mutex);
+            stopRequested = true;
+            wakeup.notify_one();
+        }
+        if (thread.joinable()) thread.join();
+
+        // records published after the thread has exited
+        drainAll();
+    }
+};
+
+RealtimeRegistry&
+registry()
+{
+    // never destroyed, as threads may exit during shutdown
+    static auto* registry = new RealtimeRegistry;
+    return *registry;
+}
+
+} // namespace
+
+log::detail::RealtimeSlot*
+log::detail::claimRealtimeSlot() noexcept
+{
+    Ring* ring = currentRing;
+    if (!ring)
+    {
+        registry().unprepared.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    std::size_t tail = ring->tail.load(std::memory_order_relaxed);
+    if (tail - ring->cachedHead > ring->mask)
+    {
+        ring->cachedHead = ring->head.load(std::memory_order_acquire);
+        if (tail - ring->cachedHead > ring->mask)
+        {
+            ring->dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+    return &ring->slots[tail & ring->mask];
+}
+
+void
+log::detail::publishRealtimeSlot() noexcept
+{
+    Ring* ring = currentRing;
+    ring->tail.store(ring->tail.load(std::memory_order_relaxed) + 1,
+                     std::memory_order_release);
+}
+
+void
+log::detail::flushRealtime()
+{
+    registry().flush();
+}
+
+void
+log::detail::stopRealtime()
+{
+    registry().stop();
+}
+
+bool
+log::Logger::prepareRealtimeThread(RealtimeOptions const& options)
+{
+    releaseRealtimeThread();
+
+    auto ring = std::make_shared<Ring>(options);
+
+    bool success = true;
+    if (options.lockMemory && !ring->lock())
+    {
+        std::cerr << "GtLogging: failed to lock the real-time records into "
+                     "memory!\n";
+        success = false;
+    }
+
+    ringHolder.ring = ring;
+    currentRing = ring.get();
+    registry().add(std::move(ring));
+    return success;
+}
+
+void
+log::Logger::releaseRealtimeThread()
+{
+    if (!ringHolder.ring) return;
+
+    currentRing = nullptr;
+    ringHolder.ring->released.store(true, std::memory_order_release);
+    ringHolder.ring.reset();
+}
+
+log::RealtimeStats
+log::Logger::realtimeStats() const
+{
+    RealtimeRegistry& r = registry();
+    MutexLocker lock(r.mutex);
+
+    RealtimeStats stats;
+    stats.dropped = r.dropped;
+    for (auto const& ring : r.rings)
+    {
+        stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    stats.unprepared = r.unprepared.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGREALTIME_H
+#define GT_LOGREALTIME_H
+
+#include "gt_logbinary.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <type_traits>
+
+namespace gt
+{
+
+namespace log
+{
+
+//! Options of a thread that uses real-time logging statements
+struct RealtimeOptions
+{
+    /// Number of preallocated records (rounded up to a power of two)
+    std::size_t capacity = 1024;
+    /// Whether the records are locked into memory (mlock/VirtualLock)
+    bool lockMemory = false;
+};
+
+//! Counters of the real-time logging statements
+struct RealtimeStats
+{
+    /// Number of records discarded as the records of a thread were in use
+    std::uint64_t dropped = 0;
+    /// Number of records discarded as the thread was not prepared
+    std::uint64_t unprepared = 0;
+};
+
+namespace detail
+{
+
+//! Preallocated record of a real-time logging statement
+struct RealtimeSlot
+{
+    /// maximum size of the encoded arguments
+    static constexpr std::size_t Capacity = 108;
+
+    /// format id of the statement
+    std::uint32_t format;
+    /// level of the statement
+    Level level;
+    /// time of the statement
+    std::int64_t time;
+    /// size of the encoded arguments
+    std::uint32_t size;
+    /// encoded arguments
+    char data[Capacity];
+};
+
+//! Returns the next free record of the calling thread or null if there is
+//! none. Never blocks, allocates or calls into the system.
+GT_LOGGING_EXPORT
+RealtimeSlot* claimRealtimeSlot() noexcept;
+
+//! Publishes the record returned by the last call to `claimRealtimeSlot`
+GT_LOGGING_EXPORT
+void publishRealtimeSlot() noexcept;
+
+//! Blocks until all published records were written
+GT_LOGGING_EXPORT
+void flushRealtime();
+
+//! Writes all published records and stops the backend thread
+GT_LOGGING_EXPORT
+void stopRealtime();
+
+//! Format id of a real-time logging statement, registered while the module
+//! of the statement is loaded. Thus the statement neither registers its
+//! format nor do its records refer to the static storage of the module,
+//! which may be unloaded before the records are written.
+template <typename Site>
+struct RealtimeFormat
+{
+    static std::uint32_t const id;
+};
+
+template <typename Site>
+std::uint32_t const RealtimeFormat<Site>::id = Site::handle().id();
+
+template <typename... Ts>
+struct AllTriviallyCopyable;
+
+template <>
+struct AllTriviallyCopyable<> : std::true_type {};
+
+template <typename T, typename... Ts>
+struct AllTriviallyCopyable<T, Ts...> :
+    std::integral_constant<bool, std::is_trivially_copyable<T>::value &&
+                                 AllTriviallyCopyable<Ts...>::value> {};
+
+/**
+ * @brief Encodes the arguments of a real-time logging statement into a
+ * preallocated record of the calling thread and publishes it. Does not
+ * block, allocate or call into the system. The record is dropped if no
+ * record is free.
+ * @param site Provides the static handle of the statement
+ * @param f Holds the format string as a constant expression
+ * @param fmt Format string
+ * @param args Arguments (trivially copyable)
+ */
+template <typename Site, typename Fmt, std::size_t N, typename... Args>
+inline void logRealtime(Site site, Fmt f,
+                        char const(&fmt)[N], Args const&... args) noexcept
+{
+    (void)FormatCheck<validateFormat(Fmt::value(),
+                                     FormatTypeList<Args...>{})>{};
+    static_assert(AllTriviallyCopyable<Args...>::value,
+                  "gtLogging: arguments of real-time logging statements must "
+                  "be trivially copyable");
+    static_assert(BinaryArgsSupported<Args...>::value,
+                  "gtLogging: real-time logging statements accept arithmetic "
+                  "values, enums and string literals only");
+    static_assert(binaryRecordSize(BinaryArg<Args>::maxSize..., 0) <=
+                  RealtimeSlot::Capacity,
+                  "gtLogging: arguments of real-time logging statement are "
+                  "too large");
+    (void)site;
+    (void)f;
+    (void)fmt;
+
+    // statements executed during static initialization may precede the
+    // registration of their format
+    std::uint32_t id = RealtimeFormat<Site>::id;
+    if (id == 0) id = Site::handle().id();
+
+    RealtimeSlot* slot = claimRealtimeSlot();
+    if (!slot) return;
+
+    char* end = encodeBinaryArgs(slot->data, args...);
+    slot->format = id;
+    slot->level = Site::handle().level();
+    slot->time = static_cast<std::int64_t>(std::time(nullptr));
+    slot->size = static_cast<std::uint32_t>(end - slot->data);
+
+    publishRealtimeSlot();
+}
+
+} // namespace detail
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGREALTIME_H
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2018 Ulf Adams
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: Apache-2.0 OR BSL-1.0
+
+#ifndef GT_LOGRYU_H
+#define GT_LOGRYU_H
+
+#include <cstdint>
+
+namespace gt
+{
+
+namespace log
+{
+
+namespace detail
+{
+
+//! Shortest decimal representation: digits * 10^exponent
+struct Decimal
+{
+    std::uint64_t digits;
+    int exponent;
+};
+
+//! Returns the shortest decimal, which reads back to the same value (Ryu).
+//! Zero is represented by zero digits. The value must be finite.
+Decimal shortestDecimal(double value);
+Decimal shortestDecimal(float value);
+
+} // namespace detail
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGRYU_H
@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logsample.h"
+
+#include <atomic>
+#include <chrono>
+
+std::uint64_t
+gt::log::detail::sampleSeed() noexcept
+{
+    // distinct for threads started at the same time
+    static std::atomic<std::uint64_t> counter{0};
+
+    std::uint64_t seed = static_cast<std::uint64_t>(
+        std::chrono::steady_clock::now().time_since_epoch().count());
+    seed += counter.fetch_add(0x9E3779B97F4A7C15ull,
+                              std::memory_order_relaxed);
+
+    // splitmix64
+    seed = (seed ^ (seed >> 30)) * 0xBF58476D1CE4E5B9ull;
+    seed = (seed ^ (seed >> 27)) * 0x94D049BB133111EBull;
+    seed ^= seed >> 31;
+
+    return seed != 0 ? seed : 0x9E3779B97F4A7C15ull;
+}
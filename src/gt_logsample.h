@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGSAMPLE_H
+#define GT_LOGSAMPLE_H
+
+#include "gt_logging_exports.h"
+#include "gt_logcontrol.h"
+
+#include <cstdint>
+
+namespace gt
+{
+
+namespace log
+{
+
+namespace detail
+{
+
+//! Returns a seed for the random generator of the calling thread. Never
+//! returns zero.
+GT_LOGGING_EXPORT
+std::uint64_t sampleSeed() noexcept;
+
+//! Returns a uniformly distributed value in [0, 1). Uses a xorshift64*
+//! generator per thread, which is seeded on its first use.
+inline double sampleUniform() noexcept
+{
+    // constant initialized, thus accessing it does not require a guard
+    static thread_local std::uint64_t state = 0;
+    if (state == 0) state = sampleSeed();
+
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    std::uint64_t value = state * 0x2545F4914F6CDD1Dull;
+
+    // upper 53 bits
+    return static_cast<double>(value >> 11) * (1.0 / 9007199254740992.0);
+}
+
+//! Decides whether an enabled execution of a sampled statement should be
+//! logged. The sampling rate of the module of the statement (see
+//! `Logger::setModuleSamplingRate`) takes precedence over the given rate.
+//! Returns the sampling weight of the message (i.e. the number of executions
+//! it represents) or zero if the execution should be skipped.
+inline double sample(CallSiteHandle& site, double rate) noexcept
+{
+    if (!site.isEnabled()) return 0.0;
+
+    double moduleRate = site.samplingRate();
+    if (moduleRate != NoSamplingRate) rate = moduleRate;
+
+    if (!(rate > 0.0)) return 0.0;
+    if (rate >= 1.0) return 1.0;
+
+    return sampleUniform() < rate ? 1.0 / rate : 0.0;
+}
+
+} // namespace detail
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGSAMPLE_H
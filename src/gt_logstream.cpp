@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logstream.h"
+
+#include <vector>
+
+using namespace gt;
+
+namespace
+{
+
+/// capacity of new buffers
+constexpr size_t InitialCapacity = 256;
+/// buffers that grew larger are not returned to the pool
+constexpr size_t MaxPooledCapacity = 64 * 1024;
+/// maximum number of buffers per thread (nested streams)
+constexpr size_t MaxPooledBuffers = 8;
+
+//! Pool of message buffers of a thread
+struct BufferPool
+{
+    std::vector<std::string*> buffers;
+
+    BufferPool() { buffers.reserve(MaxPooledBuffers); }
+    ~BufferPool();
+};
+
+// trivially destructible, thus still accessible while the pool is destroyed
+thread_local bool poolDestroyed = false;
+thread_local BufferPool pool;
+
+BufferPool::~BufferPool()
+{
+    poolDestroyed = true;
+    for (std::string* buffer : buffers) delete buffer;
+}
+
+} // namespace
+
+std::string*
+log::detail::acquireBuffer()
+{
+    if (!poolDestroyed && !pool.buffers.empty())
+    {
+        std::string* buffer = pool.buffers.back();
+        pool.buffers.pop_back();
+        return buffer;
+    }
+
+    auto* buffer = new std::string;
+    buffer->reserve(InitialCapacity);
+    return buffer;
+}
+
+void
+log::detail::releaseBuffer(std::string* buffer) noexcept
+{
+    if (!buffer) return;
+
+    if (poolDestroyed ||
+        buffer->capacity() > MaxPooledCapacity ||
+        pool.buffers.size() >= MaxPooledBuffers)
+    {
+        delete buffer;
+        return;
+    }
+
+    buffer->clear();
+    // does not allocate, capacity is reserved
+    pool.buffers.push_back(buffer);
+}
+
+log::detail::FormatStream&
+log::detail::formatStream()
+{
+    thread_local FormatStream stream;
+    return stream;
+}
@@ -5,11 +5,15 @@
 #define GT_LOGSTREAM_H
 
 #include "gt_loglevel.h"
+#include "gt_logcontrol.h"
 
 #include <algorithm>
-#include <sstream>
+#include <ostream>
+#include <locale>
+#include <string>
 #include <iomanip>
 #include <cstdint>
+#include <vector>
 
 #ifdef __has_cpp_attribute 
   #if __has_cpp_attribute(nodiscard)
@@ -31,7 +35,8 @@ namespace log
 enum StreamFlag
 {
     LogSpace = 2, // 0b0010 else no space
-    LogQuote = 4  // 0b0100 else no quote
+    LogQuote = 4, // 0b0100 else no quote
+    LogRoundTrip = 8 // 0b1000 else floats are formatted using the precision
 };
 
 class Stream;
@@ -49,27 +54,206 @@ public:
 private:
     Stream* stream;
     std::ios_base::fmtflags iosflags;
+    std::streamsize width;
+    std::streamsize precision;
+    char fill;
     int flags;
     int vlevel;
+    bool mayLog;
 };
 
+namespace detail
+{
+
+//! Returns an empty message buffer. Buffers are taken from a thread local
+//! pool and keep their capacity, thus typical messages require no heap
+//! allocation.
+GT_LOGGING_EXPORT
+std::string* acquireBuffer();
+
+//! Returns the buffer to the pool of the current thread
+GT_LOGGING_EXPORT
+void releaseBuffer(std::string* buffer) noexcept;
+
+//! Stream buffer that appends to a string
+class StringSink : public std::streambuf
+{
+public:
+
+    /// string to append to
+    std::string* target = nullptr;
+
+protected:
+
+    int_type overflow(int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            target->push_back(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(char const* s, std::streamsize n) override
+    {
+        target->append(s, static_cast<size_t>(n));
+        return n;
+    }
+};
+
+//! Thread local ostream used to format types that are not handled by the
+//! stream directly (e.g. floats or types with custom ostream operators)
+struct FormatStream
+{
+    FormatStream() { stream.imbue(std::locale::classic()); }
+
+    StringSink sink;
+    std::ostream stream{&sink};
+};
+
+//! Returns the format stream of the current thread
+GT_LOGGING_EXPORT
+FormatStream& formatStream();
+
+//! Returns the decimal digits of all numbers from 0 to 99 ("00" ... "99")
+inline char const* digitPairs() noexcept
+{
+    static constexpr char pairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233"
+        "34353637383940414243444546474849505152535455565758596061626364656667"
+        "6869707172737475767778798081828384858687888990919293949596979899";
+    return pairs;
+}
+
+//! Writes the decimal digits of value to buffer, which must hold at least 20
+//! characters. Returns the number of digits.
+inline int appendDigits(char* buffer, unsigned long long value) noexcept
+{
+    char tmp[20];
+    char* end = tmp + sizeof(tmp);
+    char* p = end;
+    while (value >= 100)
+    {
+        char const* pair = digitPairs() + (value % 100) * 2;
+        value /= 100;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    if (value >= 10)
+    {
+        char const* pair = digitPairs() + value * 2;
+        *--p = pair[1];
+        *--p = pair[0];
+    }
+    else
+    {
+        *--p = static_cast<char>('0' + value);
+    }
+
+    int length = static_cast<int>(end - p);
+    std::copy(p, end, buffer);
+    return length;
+}
+
+//! Appends the decimal representation of an unsigned integer
+inline void appendUnsigned(std::string& out, unsigned long long value,
+                           bool negative = false)
+{
+    char buffer[21];
+    char* p = buffer;
+    if (negative) *p++ = '-';
+    p += appendDigits(p, value);
+    out.append(buffer, static_cast<size_t>(p - buffer));
+}
+
+//! Format state of a stream, that is relevant for numbers
+struct NumberFormat
+{
+    std::ios_base::fmtflags flags;
+    std::streamsize width;
+    std::streamsize precision;
+    char fill;
+    /// format floating point values using the shortest representation that
+    /// reads back to the same value
+    bool roundtrip;
+};
+
+//! Appends an integer using the given format (base, width, sign etc.).
+//! Returns false if the format is not supported, nothing is appended in
+//! this case.
+GT_LOGGING_EXPORT
+bool appendInteger(std::string& out,
+                   unsigned long long value,
+                   bool negative,
+                   bool isSigned,
+                   NumberFormat const& format);
+
+//! Appends a floating point value using the given format. The output equals
+//! the output of an ostream using the classic locale. Returns false if the
+//! format or value is not supported (e.g. hexfloat, inf or nan), nothing is
+//! appended in this case.
+GT_LOGGING_EXPORT
+bool appendFloatingPoint(std::string& out,
+                         double value,
+                         NumberFormat const& format);
+
+GT_LOGGING_EXPORT
+bool appendFloatingPoint(std::string& out,
+                         float value,
+                         NumberFormat const& format);
+
+} // namespace detail
+
 //! Main stream class for logging most types. May work with Qt symbols as well.
+//! The message is written into a buffer that is reused between messages of
+//! the same thread. The format state (e.g. std::hex or std::setprecision) is
+//! stored in the stream itself.
 class Stream
 {
     friend class StreamStateSaver;
 
 public:
 
-    Stream() {
-        // manipulators
-        m_stream << std::boolalpha;
-    };
-    ~Stream() = default;
+    Stream() = default;
+    //! ctor. Associates the stream with the level of a logging statement
+    explicit Stream(Level level) : m_level(level) {}
+    ~Stream() { detail::releaseBuffer(m_buffer); }
 
     Stream(Stream const&) = delete;
-    Stream(Stream&&) = default;
+    Stream(Stream&& other) noexcept :
+        m_flags(other.m_flags),
+        m_vlevel(other.m_vlevel),
+        m_mayLog(other.m_mayLog),
+        m_level(other.m_level),
+        m_iosflags(other.m_iosflags),
+        m_width(other.m_width),
+        m_precision(other.m_precision),
+        m_fill(other.m_fill),
+        m_buffer(other.m_buffer),
+        m_fields(std::move(other.m_fields))
+    {
+        other.m_buffer = nullptr;
+    }
     Stream& operator=(Stream const&) = delete;
-    Stream& operator=(Stream&&) = default;
+    Stream& operator=(Stream&& other) noexcept
+    {
+        if (this != &other)
+        {
+            detail::releaseBuffer(m_buffer);
+            m_flags = other.m_flags;
+            m_vlevel = other.m_vlevel;
+            m_mayLog = other.m_mayLog;
+            m_level = other.m_level;
+            m_iosflags = other.m_iosflags;
+            m_width = other.m_width;
+            m_precision = other.m_precision;
+            m_fill = other.m_fill;
+            m_buffer = other.m_buffer;
+            m_fields = std::move(other.m_fields);
+            other.m_buffer = nullptr;
+        }
+        return *this;
+    }
 
     /// enables space flag, thus outputs a space after logging an element.
     /// Will only affect the next message.
@@ -82,20 +266,75 @@ public:
     inline Stream& quote()   { m_flags |=  LogQuote; return *this; }
     /// disbales the quote flag, thus logging string type without decorations.
     inline Stream& noquote() { m_flags &= ~LogQuote; return *this; }
+    /// enables the round trip flag, which formats floating point values
+    /// using the shortest representation that reads back to the same value.
+    /// The precision is ignored.
+    inline Stream& roundtrip()   { m_flags |=  LogRoundTrip; return *this; }
+    /// disables the round trip flag, thus formatting floating point values
+    /// using the precision (default).
+    inline Stream& noroundtrip() { m_flags &= ~LogRoundTrip; return *this; }
+
+    /// sets the format flags selected by mask (see std::ios_base::setf)
+    inline Stream& setf(std::ios_base::fmtflags flags,
+                        std::ios_base::fmtflags mask)
+    {
+        m_iosflags = (m_iosflags & ~mask) | (flags & mask);
+        return *this;
+    }
+    /// sets the field width of the next element
+    inline Stream& width(std::streamsize w) { m_width = w; return *this; }
+    /// sets the precision of floating point values
+    inline Stream& precision(std::streamsize p) { m_precision = p; return *this; }
+    /// sets the fill character used for padding
+    inline Stream& fill(char c) { m_fill = c; return *this; }
+
+    //! Appends the text as is. Flags are not applied.
+    inline Stream& append(char const* text, std::size_t size)
+    {
+        if (mayLog()) buffer().append(text, size);
+        return *this;
+    }
 
     Stream& medium() { return verbose(gt::log::Medium); }
     Stream& verbose(int level = gt::log::Everything)
     {
         m_vlevel = level;
+        m_mayLog = mayLog(level);
         return *this;
     }
 
-    std::string str() { return m_stream.str(); }
+    //! Returns a copy of the message
+    std::string str() const { return message(); }
 
-    GT_LOGGING_EXPORT static bool mayLog(int level);
-    GT_LOG_NODISCARD bool mayLog() const { return mayLog(m_vlevel); }
+    //! Returns the message without copying it. The reference is valid until
+    //! the stream is modified or destroyed.
+    std::string const& message() const
+    {
+        static std::string const empty;
+        return m_buffer ? *m_buffer : empty;
+    }
+
+    //! Returns the structured fields of the message (see `field`)
+    std::vector<Field> const& fields() const { return m_fields; }
+
+    static bool mayLog(int level) { return detail::isVerbosityEnabled(level); }
+    //! Returns whether the stream logs at all. The verbosity is evaluated only
+    //! once per statement, i.e. when the stream is created or when its
+    //! verbosity level is set.
+    GT_LOG_NODISCARD bool mayLog() const { return m_mayLog; }
+    //! Returns the level of the logging statement or OffLevel if the stream
+    //! is not associated with a logging statement
+    GT_LOG_NODISCARD Level level() const { return m_level; }
     GT_LOG_NODISCARD bool mayLogSpace() const { return m_flags & LogSpace; }
     GT_LOG_NODISCARD bool mayLogQuote() const { return m_flags & LogQuote; }
+    GT_LOG_NODISCARD bool mayLogRoundTrip() const { return m_flags & LogRoundTrip; }
+
+    //! Attaches the field to the message instead of appending it to the text
+    inline Stream& operator<<(Field field)
+    {
+        if (mayLog()) m_fields.push_back(std::move(field));
+        return *this;
+    }
 
     // pod
     inline Stream& operator<<(std::nullptr_t) { return doLog("(nullptr)"); }
@@ -147,7 +386,11 @@ public:
     inline Stream& operator<<(float t) { return doLog(t); }
     inline Stream& operator<<(double t) { return doLog(t); }
 
-    // strings
+    // strings. Always copied into the buffer: a string literal cannot be told
+    // apart from other character arrays or pointers, whose storage may be
+    // released before the message is written at the end of the statement
+    // (e.g. `gtInfo() << str().c_str()`). Short messages are not allocated
+    // anyway, as the buffers are pooled.
     inline Stream& operator<<(const char* t) { return doLog(t); }
 
     template <typename... Ts>
@@ -156,13 +399,13 @@ public:
     // ios flags, like std::hex
     inline Stream& operator<<(std::ios_base&(*t)(std::ios_base&))
     {
-        if (mayLog()) m_stream << t;
+        if (mayLog()) format(t);
         return *this;
     }
     // ios operators, like std::endl etc
     inline Stream& operator<<(std::ostream&(*f)(std::ostream&))
     {
-        if (mayLog()) f(m_stream);
+        if (mayLog()) format(f);
         return *this;
     }
     // ios modifers, like setw, setprecision...
@@ -175,7 +418,7 @@ public:
                   std::is_same<MANIP, decltype(std::setbase(0))>::value, bool> = true>
     inline Stream& operator<<(MANIP const& manip)
     {
-        if (mayLog()) m_stream << manip;
+        if (mayLog()) format(manip);
         return *this;
     }
 
@@ -185,7 +428,7 @@ public:
     {
         if (mayLog())
         {
-            m_stream << t;
+            put(t);
             doLogSpace();
         }
         return *this;
@@ -198,7 +441,7 @@ public:
         if (mayLog())
         {
             doLogQuote();
-            m_stream << t;
+            put(t);
             doLogQuote().doLogSpace();
         }
         return *this;
@@ -213,14 +456,14 @@ public:
     //! Helper function to log ' '
     inline Stream& doLogSpace() noexcept
     {
-        if (mayLogSpace()) m_stream << ' ';
+        if (mayLogSpace()) buffer().push_back(' ');
         return *this;
     };
 
     //! Helper function to log '"'
     inline Stream& doLogQuote() noexcept
     {
-        if (mayLogQuote()) m_stream << '"';
+        if (mayLogQuote()) buffer().push_back('"');
         return *this;
     };
 
@@ -230,8 +473,186 @@ private:
     int m_flags{gt::log::LogSpace};
     /// verbosity level
     int m_vlevel{gt::log::Silent};
-    /// ostream
-    std::ostringstream m_stream;
+    /// whether the verbosity level is enabled
+    bool m_mayLog{mayLog(gt::log::Silent)};
+    /// level of the logging statement
+    Level m_level{gt::log::OffLevel};
+    /// format flags
+    std::ios_base::fmtflags m_iosflags{std::ios_base::dec |
+                                       std::ios_base::skipws |
+                                       std::ios_base::boolalpha};
+    /// field width of the next element
+    std::streamsize m_width{0};
+    /// precision of floating point values
+    std::streamsize m_precision{6};
+    /// fill character
+    char m_fill{' '};
+    /// message buffer (acquired on first use)
+    std::string* m_buffer{nullptr};
+    /// structured fields
+    std::vector<Field> m_fields;
+
+    //! Returns the message buffer
+    std::string& buffer()
+    {
+        if (!m_buffer) m_buffer = detail::acquireBuffer();
+        return *m_buffer;
+    }
+
+    //! Returns whether the value can be written without the format stream
+    bool isPlain() const noexcept
+    {
+        return m_width == 0;
+    }
+
+    //! Returns whether integers can be written without the format stream
+    bool isPlainDecimal() const noexcept
+    {
+        constexpr auto special = std::ios_base::hex | std::ios_base::oct |
+                                 std::ios_base::showpos;
+        return m_width == 0 && !(m_iosflags & special);
+    }
+
+    //! Writes t using the thread local format stream. Applies the format
+    //! state of this stream and stores the modified state afterwards.
+    template <typename T>
+    void format(T const& t)
+    {
+        detail::FormatStream& fs = detail::formatStream();
+        std::ostream& os = fs.stream;
+
+        // the format stream may be in use if t itself is logging
+        std::string* target = fs.sink.target;
+        std::ios_base::fmtflags flags = os.flags();
+        std::streamsize width = os.width();
+        std::streamsize precision = os.precision();
+        char fill = os.fill();
+
+        fs.sink.target = &buffer();
+        os.flags(m_iosflags);
+        os.width(m_width);
+        os.precision(m_precision);
+        os.fill(m_fill);
+
+        os << t;
+
+        m_iosflags = os.flags();
+        m_width = os.width();
+        m_precision = os.precision();
+        m_fill = os.fill();
+
+        fs.sink.target = target;
+        os.flags(flags);
+        os.width(width);
+        os.precision(precision);
+        os.fill(fill);
+        os.clear();
+    }
+
+    template <typename T>
+    void put(T const& t) { format(t); }
+
+    void put(char const* t)
+    {
+        if (!isPlain() || !t) return format(t);
+        buffer().append(t);
+    }
+
+    template <typename... Ts>
+    void put(std::basic_string<char, Ts...> const& t)
+    {
+        if (!isPlain()) return format(t);
+        buffer().append(t.data(), t.size());
+    }
+
+    void put(char t)
+    {
+        if (!isPlain()) return format(t);
+        buffer().push_back(t);
+    }
+
+    void put(bool t)
+    {
+        if (!isPlain()) return format(t);
+        if (m_iosflags & std::ios_base::boolalpha)
+        {
+            buffer().append(t ? "true" : "false");
+        }
+        else
+        {
+            buffer().push_back(t ? '1' : '0');
+        }
+    }
+
+    //! Returns the format state relevant for numbers
+    detail::NumberFormat numberFormat() const noexcept
+    {
+        return {m_iosflags, m_width, m_precision, m_fill, mayLogRoundTrip()};
+    }
+
+    template <typename T>
+    void putSigned(T t)
+    {
+        using U = std::make_unsigned_t<T>;
+        bool negative = t < 0;
+        U value = negative ? U(0) - static_cast<U>(t) : static_cast<U>(t);
+        if (isPlainDecimal())
+        {
+            return detail::appendUnsigned(buffer(), value, negative);
+        }
+
+        // other bases use the two's complement
+        auto basefield = m_iosflags & std::ios_base::basefield;
+        if (basefield == std::ios_base::hex || basefield == std::ios_base::oct)
+        {
+            value = static_cast<U>(t);
+            negative = false;
+        }
+        putInteger(t, value, negative, true);
+    }
+
+    template <typename T>
+    void putUnsigned(T t)
+    {
+        if (isPlainDecimal()) return detail::appendUnsigned(buffer(), t);
+        putInteger(t, t, false, false);
+    }
+
+    template <typename T>
+    void putInteger(T t, unsigned long long value, bool negative, bool isSigned)
+    {
+        if (!detail::appendInteger(buffer(), value, negative, isSigned,
+                                   numberFormat()))
+        {
+            return format(t);
+        }
+        m_width = 0;
+    }
+
+    template <typename T>
+    void putFloatingPoint(T t)
+    {
+        if (!detail::appendFloatingPoint(buffer(), t, numberFormat()))
+        {
+            return format(t);
+        }
+        m_width = 0;
+    }
+
+    void put(short t) { putSigned(t); }
+    void put(int t) { putSigned(t); }
+    void put(long t) { putSigned(t); }
+    void put(long long t) { putSigned(t); }
+    void put(unsigned short t) { putUnsigned(t); }
+    void put(unsigned int t) { putUnsigned(t); }
+    void put(unsigned long t) { putUnsigned(t); }
+    void put(unsigned long long t) { putUnsigned(t); }
+    // code units are logged as numbers, as the ostream operators are deleted
+    // since C++20
+    void put(char16_t t) { putUnsigned(static_cast<unsigned>(t)); }
+    void put(char32_t t) { putUnsigned(static_cast<unsigned>(t)); }
+    void put(float t) { putFloatingPoint(t); }
+    void put(double t) { putFloatingPoint(t); }
 };
 
 // pair
@@ -255,7 +676,7 @@ inline Stream& Stream::doLogIter(Iter a, Iter b,
 {
     if (mayLog())
     {
-        m_stream << pre;
+        buffer().append(pre);
         if (a != b)
         {
             StreamStateSaver s{*this};
@@ -265,14 +686,14 @@ inline Stream& Stream::doLogIter(Iter a, Iter b,
             // log until nth - 1 element
             std::for_each(a, b_1, [this, sep](auto const& val){
                 *this << val;
-                m_stream << sep;
+                buffer().append(sep);
             });
             // log nth element
             std::for_each(b_1, b, [this](auto const& val){
                 *this << val;
             });
         }
-        m_stream << suf;
+        buffer().append(suf);
         doLogSpace();
     }
     return *this;
@@ -284,6 +705,9 @@ inline Stream& space(Stream& s) { return s.space(); }
 inline Stream& noquote(Stream& s) { return s.noquote(); }
 inline Stream& quote(Stream& s) { return s.quote(); }
 
+inline Stream& noroundtrip(Stream& s) { return s.noroundtrip(); }
+inline Stream& roundtrip(Stream& s) { return s.roundtrip(); }
+
 inline Stream&
 operator<<(Stream& s, Stream&(*f)(Stream&))
 {
@@ -352,16 +776,24 @@ operator<<(Stream& s, detail::RangeType<Iter> r)
 
 inline gt::log::StreamStateSaver::StreamStateSaver(Stream& s)
     : stream{&s}
-    , iosflags{s.m_stream.flags()}
+    , iosflags{s.m_iosflags}
+    , width{s.m_width}
+    , precision{s.m_precision}
+    , fill{s.m_fill}
     , flags{s.m_flags}
     , vlevel{s.m_vlevel}
+    , mayLog{s.m_mayLog}
 {}
 
 inline gt::log::StreamStateSaver::~StreamStateSaver()
 {
-    stream->m_stream.setf(iosflags);
+    stream->m_iosflags = iosflags;
+    stream->m_width = width;
+    stream->m_precision = precision;
+    stream->m_fill = fill;
     stream->m_flags = flags;
     stream->m_vlevel = vlevel;
+    stream->m_mayLog = mayLog;
 }
 
 #endif // GT_LOGSTREAM_H
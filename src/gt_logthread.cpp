@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gt_logthread.h"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#elif defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+using namespace gt;
+
+using MutexLocker = const std::lock_guard<std::mutex>;
+
+namespace
+{
+
+//! Returns the id of the calling thread as assigned by the OS
+std::uint64_t
+osThreadId()
+{
+#if defined(_WIN32)
+    return static_cast<std::uint64_t>(GetCurrentThreadId());
+#elif defined(__linux__)
+    return static_cast<std::uint64_t>(::syscall(SYS_gettid));
+#elif defined(__APPLE__)
+    std::uint64_t id = 0;
+    pthread_threadid_np(nullptr, &id);
+    return id;
+#else
+    // sequential ids otherwise
+    static std::atomic<std::uint64_t> next{1};
+    return next.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+//! Stores the thread names, such that records may refer to them after the
+//! thread has exited
+struct ThreadNames
+{
+    std::mutex mutex;
+    std::set<std::string> names;
+
+    char const* intern(std::string const& name)
+    {
+        MutexLocker lock(mutex);
+        return names.insert(name).first->c_str();
+    }
+};
+
+ThreadNames&
+threadNames()
+{
+    // never destroyed, as records may be written during shutdown
+    static auto* names = new ThreadNames;
+    return *names;
+}
+
+log::ThreadInfo&
+threadInfo() noexcept
+{
+    thread_local log::ThreadInfo info{osThreadId(), ""};
+    return info;
+}
+
+} // namespace
+
+void
+log::setThreadName(std::string const& name)
+{
+    threadInfo().name = name.empty() ? "" : threadNames().intern(name);
+}
+
+log::ThreadInfo const&
+log::currentThread() noexcept
+{
+    return threadInfo();
+}
@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef GT_LOGTHREAD_H
+#define GT_LOGTHREAD_H
+
+#include "gt_logging_exports.h"
+#include "gt_loglevel.h"
+
+#include <string>
+
+namespace gt
+{
+
+namespace log
+{
+
+//! Sets the name of the calling thread, which is passed to the destinations
+//! in `Details::thread`. Names are stored for the lifetime of the process,
+//! thus threads should not be renamed excessively.
+GT_LOGGING_EXPORT
+void setThreadName(std::string const& name);
+
+//! Returns the identity of the calling thread. The OS thread id is queried
+//! once per thread, subsequent calls only access thread local storage.
+GT_LOGGING_EXPORT
+ThreadInfo const& currentThread() noexcept;
+
+} // namespace log
+
+} // namespace gt
+
+#endif // GT_LOGTHREAD_H
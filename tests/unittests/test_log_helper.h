@@ -11,6 +11,11 @@
 #include <QObject>
 #include <QDebug>
 
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
 // log helper
 class LogHelperTest : public testing::Test
 {
@@ -52,6 +57,65 @@ public:
     QString log;
 };
 
+// log helper, that records the messages along with their details
+class LogRecordTest : public LogHelperTest
+{
+public:
+
+    struct Record
+    {
+        std::string message;
+        gt::log::Level level;
+        gt::log::Details details;
+    };
+
+    void SetUp() override
+    {
+        LogHelperTest::SetUp();
+
+        ASSERT_TRUE(logger.addDestination(recordid,
+                                          gt::log::makeFunctorDestination(
+            [this](std::string const& msg, gt::log::Level level,
+                   gt::log::Details const& details){
+            std::lock_guard<std::mutex> lock(mutex);
+            records.push_back({msg, level, details});
+        })));
+    }
+
+    void TearDown() override
+    {
+        logger.removeDestination(recordid);
+        LogHelperTest::TearDown();
+    }
+
+    //! Returns the number of records of the given level
+    size_t count(gt::log::Level level)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::count_if(records.begin(), records.end(),
+                             [level](Record const& r){
+            return r.level == level;
+        });
+    }
+
+    //! Returns the field of the record or null
+    static gt::log::Field const* field(Record const& record,
+                                       std::string const& key)
+    {
+        auto const& fields = record.details.fields;
+        auto iter = std::find_if(fields.begin(), fields.end(),
+                                 [&key](gt::log::Field const& f){
+            return f.key == key;
+        });
+        return iter != fields.end() ? &*iter : nullptr;
+    }
+
+    std::string recordid = "LogRecordTest";
+    /// guards the records, which are appended by any thread
+    std::mutex mutex;
+    std::vector<Record> records;
+};
+
 // custom struct
 struct MyStruct
 {
@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/seccomp.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+// allocations of threads that enabled counting
+thread_local bool countAllocations = false;
+std::atomic<int> allocations{0};
+
+} // namespace
+
+// replacements of the global allocation functions, thus these tests are built
+// as a separate executable. GCC mistakes them for a mismatch of new and free
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+    if (countAllocations) ++allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+class LogAllocations : public LogHelperTest
+{
+public:
+
+    void TearDown() override
+    {
+        countAllocations = false;
+        logger.releaseRealtimeThread();
+        logger.clearModuleLoggingLevels();
+        LogHelperTest::TearDown();
+    }
+};
+
+// the module levels are cached per thread, looking up a cached id does not
+// allocate
+TEST_F(LogAllocations, moduleLevels)
+{
+    logger.setModuleLoggingLevel("gtlab.core.solver*", gt::log::ErrorLevel);
+
+    // longer than the buffer of small strings, the first id is the one the
+    // statement is registered with
+    char const* ids[] = {"gtlab.core.solver.newton.linesearch",
+                         "gtlab.core.solver.newton.jacobian"};
+    auto const logIds = [&ids](){
+        for (char const* id : ids) gtDebugId(id) << "disabled";
+    };
+
+    // resolves and caches the levels
+    logIds();
+
+    allocations = 0;
+    countAllocations = true;
+    for (int i = 0; i < 100; ++i) logIds();
+    countAllocations = false;
+
+    EXPECT_EQ(allocations.load(), 0);
+    EXPECT_FALSE(log.contains("disabled"));
+}
+
+// the producer must not allocate or call into the system: the logging thread
+// runs in seccomp strict mode, which kills the process on any system call
+// except for read, write, exit and sigreturn
+TEST_F(LogAllocations, noAllocationsNoSystemCalls)
+{
+#ifndef __linux__
+    GTEST_SKIP() << "requires seccomp";
+#else
+    constexpr int N = 500;
+
+    // no thread of the registry may hold a lock while forking
+    gt::log::detail::stopRealtime();
+
+    // result of the logging thread and a pipe to block it forever
+    int pipes[2], blocking[2];
+    ASSERT_EQ(pipe(pipes), 0);
+    ASSERT_EQ(pipe(blocking), 0);
+
+    pid_t pid = fork();
+    ASSERT_NE(pid, -1);
+
+    if (pid == 0)
+    {
+        std::thread([&](){
+            gt::log::RealtimeOptions options;
+            options.capacity = N;
+            options.lockMemory = true;
+            // locking may be denied by resource limits
+            logger.prepareRealtimeThread(options);
+
+            countAllocations = true;
+            if (prctl(PR_SET_SECCOMP, SECCOMP_MODE_STRICT) != 0) _exit(2);
+
+            for (int i = 0; i < N; ++i)
+            {
+                gtInfoRt("sample {} value {:.3f} {}", i, i * 0.5, "ok");
+            }
+
+            int result = allocations.load();
+            (void)write(pipes[1], &result, sizeof(result));
+
+            // exiting the thread would call into the system
+            char c;
+            for (;;) (void)read(blocking[0], &c, 1);
+        }).detach();
+
+        int result = -1;
+        if (read(pipes[0], &result, sizeof(result)) != sizeof(result)) _exit(3);
+        _exit(result == 0 ? 0 : 1);
+    }
+
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    for (int fd : {pipes[0], pipes[1], blocking[0], blocking[1]}) close(fd);
+
+    // killed by SIGKILL if a forbidden system call was made
+    ASSERT_TRUE(WIFEXITED(status)) << "terminated by signal "
+                                   << WTERMSIG(status);
+    EXPECT_EQ(WEXITSTATUS(status), 0) << "allocations on the logging thread";
+#endif
+}
@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <atomic>
+#include <thread>
+
+class LogAsync : public LogHelperTest
+{
+    void TearDown() override
+    {
+        logger.disableAsync();
+        EXPECT_FALSE(logger.isAsync());
+        LogHelperTest::TearDown();
+    }
+};
+
+TEST_F(LogAsync, enableDisable)
+{
+    ASSERT_FALSE(logger.isAsync());
+
+    EXPECT_TRUE(logger.enableAsync());
+    EXPECT_TRUE(logger.isAsync());
+    // already enabled
+    EXPECT_FALSE(logger.enableAsync());
+
+    logger.disableAsync();
+    EXPECT_FALSE(logger.isAsync());
+}
+
+TEST_F(LogAsync, flush)
+{
+    ASSERT_TRUE(logger.enableAsync());
+
+    gtInfo() << "Async message";
+    logger.flush();
+
+    EXPECT_TRUE(log.contains("Async message"));
+}
+
+TEST_F(LogAsync, drainOnDisable)
+{
+    ASSERT_TRUE(logger.enableAsync());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        gtInfo() << "Drained";
+    }
+    logger.disableAsync();
+
+    EXPECT_EQ(log.count("Drained"), 100);
+}
+
+TEST_F(LogAsync, multipleProducers)
+{
+    gt::log::AsyncOptions options;
+    options.capacity = 16;
+    options.overflowPolicy = gt::log::BlockOnOverflow;
+    ASSERT_TRUE(logger.enableAsync(options));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([](){
+            for (int i = 0; i < 250; ++i) gtInfo() << "Producer";
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    logger.flush();
+    EXPECT_EQ(log.count("Producer"), 1000);
+}
+
+// producers may still push into a backend that is stopped or has exited
+TEST_F(LogAsync, blockWhileDisabling)
+{
+    gt::log::AsyncOptions options;
+    options.capacity = 1;
+    options.overflowPolicy = gt::log::BlockOnOverflow;
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&](){
+            for (int i = 0; i < 500; ++i) gtInfo() << "Producer";
+        });
+    }
+    std::thread toggle([&](){
+        while (!done)
+        {
+            logger.enableAsync(options);
+            logger.disableAsync();
+        }
+    });
+    for (auto& thread : threads) thread.join();
+    done = true;
+    toggle.join();
+
+    logger.flush();
+    EXPECT_EQ(log.count("Producer"), 2000);
+}
+
+TEST_F(LogAsync, overflowPolicies)
+{
+    std::atomic<bool> release{false};
+    auto blocking = gt::log::makeFunctorDestination(
+        [&](std::string const&, gt::log::Level, gt::log::Details const&){
+        while (!release) std::this_thread::yield();
+    });
+    ASSERT_TRUE(logger.addDestination("blocking", std::move(blocking)));
+
+    gt::log::AsyncOptions options;
+    options.capacity = 4;
+
+    auto stats = logger.asyncStats();
+
+    // drop newest
+    options.overflowPolicy = gt::log::DropNewestOnOverflow;
+    ASSERT_TRUE(logger.enableAsync(options));
+    for (int i = 0; i < 20; ++i) gtInfo() << "DropNewest";
+    release = true;
+    logger.disableAsync();
+
+    auto newStats = logger.asyncStats();
+    EXPECT_GT(newStats.droppedNewest, stats.droppedNewest);
+    EXPECT_EQ(newStats.droppedOldest, stats.droppedOldest);
+    EXPECT_EQ(log.count("DropNewest") +
+              (newStats.droppedNewest - stats.droppedNewest), 20);
+
+    // drop oldest
+    release = false;
+    stats = newStats;
+    options.overflowPolicy = gt::log::DropOldestOnOverflow;
+    ASSERT_TRUE(logger.enableAsync(options));
+    for (int i = 0; i < 20; ++i) gtInfo() << "DropOldest" << i;
+    release = true;
+    logger.disableAsync();
+
+    newStats = logger.asyncStats();
+    EXPECT_GT(newStats.droppedOldest, stats.droppedOldest);
+    // the newest message is kept
+    EXPECT_TRUE(log.contains("DropOldest 19"));
+
+    logger.removeDestination("blocking");
+}
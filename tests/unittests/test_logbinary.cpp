@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+class LogBinary : public LogHelperTest
+{
+public:
+    std::string filePath = "test_logbinary.gtlogb";
+
+    void TearDown() override
+    {
+        logger.closeBinaryLog();
+        std::remove(filePath.c_str());
+        LogHelperTest::TearDown();
+    }
+
+    struct Entry
+    {
+        std::string message;
+        gt::log::Level level;
+        std::string id;
+    };
+
+    bool read(std::vector<Entry>& entries, std::istream& in)
+    {
+        return gt::log::readBinaryLog(in, [&](std::string const& msg,
+                                              gt::log::Level level,
+                                              gt::log::Details const& details){
+            entries.push_back({msg, level, details.id});
+        });
+    }
+};
+
+enum Phase { Init = 3, Solve = 7 };
+
+TEST_F(LogBinary, formattedForDestinations)
+{
+    gtInfoB("x={} y={:.2f} s={}", 42, 3.14159, "str");
+    EXPECT_TRUE(log.contains("x=42 y=3.14 s=str"));
+    log.clear();
+
+    gtWarningB("{:#x} {} {} {} {}", -1, Solve, 'c', true, 12345678901234ull);
+    EXPECT_TRUE(log.contains("0xffffffff 7 c true 12345678901234"));
+}
+
+TEST_F(LogBinary, async)
+{
+    ASSERT_TRUE(logger.enableAsync());
+    gtInfoB("async {}", 1.5f);
+    logger.flush();
+    logger.disableAsync();
+    EXPECT_TRUE(log.contains("async 1.5"));
+}
+
+TEST_F(LogBinary, file)
+{
+    ASSERT_TRUE(logger.openBinaryLog(filePath));
+    ASSERT_TRUE(logger.isBinaryLogOpen());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        gtInfoB("iteration {} residual {:.3e}", i, 1.0 / (i + 1));
+    }
+    gtErrorB("{{done}} {:>6}", short(-5));
+    logger.closeBinaryLog();
+
+    // records are not sent to the destinations
+    EXPECT_TRUE(log.isEmpty());
+
+    std::ifstream in(filePath, std::ios::binary);
+    std::vector<Entry> entries;
+    ASSERT_TRUE(read(entries, in));
+    ASSERT_EQ(entries.size(), 4u);
+
+    EXPECT_EQ(entries[0].message, "iteration 0 residual 1.000e+00 ");
+    EXPECT_EQ(entries[2].message, "iteration 2 residual 3.333e-01 ");
+    EXPECT_EQ(entries[2].level, gt::log::InfoLevel);
+    EXPECT_EQ(entries[3].message, "{done}     -5 ");
+    EXPECT_EQ(entries[3].level, gt::log::ErrorLevel);
+
+    // same text as the format string macros
+    gtInfoF("iteration {} residual {:.3e}", 1, 0.5);
+    EXPECT_TRUE(log.contains(QString::fromStdString(entries[1].message)));
+}
+
+// statements expanded from a single macro share the line
+#define GT_LOG_TEST_BOTH(x) gtInfoB("value {}", x); gtErrorB("value {}", x)
+
+TEST_F(LogBinary, sameLine)
+{
+    ASSERT_TRUE(logger.openBinaryLog(filePath));
+    GT_LOG_TEST_BOTH(1);
+    logger.closeBinaryLog();
+
+    std::ifstream in(filePath, std::ios::binary);
+    std::vector<Entry> entries;
+    ASSERT_TRUE(read(entries, in));
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].level, gt::log::InfoLevel);
+    EXPECT_EQ(entries[1].level, gt::log::ErrorLevel);
+}
+
+// filled blocks are written by the writer thread
+TEST_F(LogBinary, fileConcurrent)
+{
+    ASSERT_TRUE(logger.openBinaryLog(filePath));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([t](){
+            for (int i = 0; i < 10000; ++i)
+            {
+                gtInfoB("thread {} record {} payload {}", t, i,
+                        "0123456789abcdef");
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // flushes all blocks
+    logger.flush();
+    {
+        std::ifstream in(filePath, std::ios::binary);
+        std::vector<Entry> entries;
+        ASSERT_TRUE(read(entries, in));
+        EXPECT_EQ(entries.size(), 40000u);
+    }
+
+    gtInfoB("after flush");
+    logger.closeBinaryLog();
+
+    std::ifstream in(filePath, std::ios::binary);
+    std::vector<Entry> entries;
+    ASSERT_TRUE(read(entries, in));
+    ASSERT_EQ(entries.size(), 40001u);
+    EXPECT_EQ(entries.back().message, "after flush ");
+}
+
+TEST_F(LogBinary, corrupted)
+{
+    ASSERT_TRUE(logger.openBinaryLog(filePath));
+    gtInfoB("value {}", 42);
+    logger.closeBinaryLog();
+
+    std::ifstream in(filePath, std::ios::binary);
+    std::string data{std::istreambuf_iterator<char>(in), {}};
+
+    std::vector<Entry> entries;
+    std::istringstream truncated(data.substr(0, data.size() - 2));
+    EXPECT_FALSE(read(entries, truncated));
+    EXPECT_TRUE(entries.empty());
+
+    std::istringstream invalid("GTLOG");
+    EXPECT_FALSE(read(entries, invalid));
+
+    // sizes exceeding the file
+    std::string const header = data.substr(0, 8);
+    auto const chunk = [](char kind, std::uint32_t size){
+        std::string chunk(1, kind);
+        std::uint32_t id = 1;
+        std::int32_t zero = 0;
+        std::int64_t time = 0;
+        chunk.append(reinterpret_cast<char const*>(&id), 4);
+        if (kind == 1)
+        {
+            // level and line
+            chunk.append(reinterpret_cast<char const*>(&zero), 4);
+            chunk.append(reinterpret_cast<char const*>(&zero), 4);
+        }
+        else
+        {
+            chunk.append(reinterpret_cast<char const*>(&time), 8);
+        }
+        chunk.append(reinterpret_cast<char const*>(&size), 4);
+        return chunk + "data";
+    };
+
+    std::istringstream hugeString(header + chunk(1, 0xFFFFFFFFu));
+    EXPECT_FALSE(read(entries, hugeString));
+
+    std::istringstream hugeRecord(header + chunk(2, 0xFFFFFFF0u));
+    EXPECT_FALSE(read(entries, hugeRecord));
+    EXPECT_TRUE(entries.empty());
+}
+
+TEST_F(LogBinary, noEvaluation)
+{
+    int evaluated = 0;
+
+    logger.setLoggingLevel(gt::log::InfoLevel);
+    gtDebugB("{}", ++evaluated);
+    EXPECT_EQ(evaluated, 0);
+
+    gtInfoB("{}", ++evaluated);
+    EXPECT_EQ(evaluated, 1);
+}
@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+class LogBudget : public LogRecordTest
+{
+public:
+
+    void SetUp() override
+    {
+        LogRecordTest::SetUp();
+        logger.setLoggingLevel(gt::log::TraceLevel);
+    }
+
+    void TearDown() override
+    {
+        logger.setBudget({});
+        LogRecordTest::TearDown();
+    }
+
+    //! Returns the unsigned field of the record or the maximum value if it is
+    //! missing
+    static std::uint64_t number(Record const& record, std::string const& key)
+    {
+        auto const* f = field(record, key);
+        return f ? f->number.u : std::numeric_limits<std::uint64_t>::max();
+    }
+};
+
+TEST_F(LogBudget, disabledByDefault)
+{
+    EXPECT_FALSE(logger.budgetState().enabled);
+
+    for (int i = 0; i < 100; ++i) gtTrace() << "unlimited";
+    EXPECT_EQ(count(gt::log::TraceLevel), 100u);
+}
+
+// lower levels are dropped first
+TEST_F(LogBudget, levels)
+{
+    gt::log::LogBudget budget;
+    budget.messagesPerSecond = 10;
+    logger.setBudget(budget);
+
+    auto state = logger.budgetState();
+    EXPECT_TRUE(state.enabled);
+    EXPECT_NEAR(state.messageTokens, 10.0, 0.1);
+
+    for (int i = 0; i < 10; ++i) gtTrace() << "trace";
+    for (int i = 0; i < 10; ++i) gtDebug() << "debug";
+    for (int i = 0; i < 10; ++i) gtInfo() << "info";
+
+    // trace keeps 2/3 of the bucket in reserve, debug 1/3
+    EXPECT_EQ(count(gt::log::TraceLevel), 3u);
+    EXPECT_EQ(count(gt::log::DebugLevel), 3u);
+    EXPECT_EQ(count(gt::log::InfoLevel), 4u);
+
+    // always admitted
+    for (int i = 0; i < 10; ++i) gtWarning() << "warning";
+    for (int i = 0; i < 10; ++i) gtError() << "error";
+    EXPECT_EQ(count(gt::log::WarningLevel), 10u);
+    EXPECT_EQ(count(gt::log::ErrorLevel), 10u);
+
+    state = logger.budgetState();
+    EXPECT_EQ(state.droppedTrace, 7u);
+    EXPECT_EQ(state.droppedDebug, 7u);
+    EXPECT_EQ(state.droppedInfo, 6u);
+    // only the first dropped message of a level is built, the following
+    // statements are shed by the level check
+    EXPECT_EQ(state.droppedBytes, 6u + 6u + 5u);
+    EXPECT_LT(state.messageTokens, 1.0);
+}
+
+TEST_F(LogBudget, shedStatementsAreNotBuilt)
+{
+    gt::log::LogBudget budget;
+    budget.messagesPerSecond = 1;
+    logger.setBudget(budget);
+
+    gtInfo() << "admitted";
+    gtInfo() << "dropped";
+
+    int evaluated = 0;
+    gtInfo() << ++evaluated;
+    gtDebugId("module") << ++evaluated;
+    gtTraceFirstN(1) << ++evaluated;
+    EXPECT_EQ(evaluated, 0);
+
+    auto state = logger.budgetState();
+    EXPECT_EQ(state.droppedInfo, 2u);
+    EXPECT_EQ(state.droppedDebug, 1u);
+    EXPECT_EQ(state.droppedTrace, 1u);
+
+    gtWarning() << ++evaluated;
+    EXPECT_EQ(evaluated, 1);
+}
+
+TEST_F(LogBudget, bytes)
+{
+    gt::log::LogBudget budget;
+    budget.bytesPerSecond = 100;
+    logger.setBudget(budget);
+
+    std::string const message(30, 'x');
+    for (int i = 0; i < 10; ++i) gtInfo().nospace() << message;
+
+    EXPECT_EQ(count(gt::log::InfoLevel), 3u);
+    EXPECT_EQ(logger.budgetState().droppedBytes, 7u * 30);
+}
+
+// messages exceeding the bucket are admitted if the bucket is full
+TEST_F(LogBudget, oversized)
+{
+    gt::log::LogBudget budget;
+    budget.bytesPerSecond = 10;
+    logger.setBudget(budget);
+
+    std::string const message(100, 'x');
+    gtInfo().nospace() << message;
+    gtInfo().nospace() << message;
+
+    EXPECT_EQ(count(gt::log::InfoLevel), 1u);
+    EXPECT_EQ(logger.budgetState().droppedBytes, 100u);
+}
+
+TEST_F(LogBudget, refill)
+{
+    gt::log::LogBudget budget;
+    budget.messagesPerSecond = 100;
+    budget.burst = std::chrono::milliseconds{100};
+    logger.setBudget(budget);
+
+    for (int i = 0; i < 20; ++i) gtInfo() << "burst";
+    EXPECT_EQ(count(gt::log::InfoLevel), 10u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    for (int i = 0; i < 20; ++i) gtInfo() << "burst";
+    EXPECT_EQ(count(gt::log::InfoLevel), 20u);
+}
+
+TEST_F(LogBudget, summary)
+{
+    gt::log::LogBudget budget;
+    budget.messagesPerSecond = 1;
+    budget.summaryInterval = std::chrono::milliseconds{50};
+    logger.setBudget(budget);
+
+    gtInfo() << "admitted";
+    for (int i = 0; i < 5; ++i) gtDebug() << "dropped";
+    EXPECT_EQ(records.size(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    // logged before the next message that reaches the logger
+    gtWarning() << "warning";
+
+    ASSERT_EQ(records.size(), 3u);
+    Record const& summary = records[1];
+    EXPECT_EQ(summary.level, gt::log::WarningLevel);
+    EXPECT_EQ(summary.message, "messages dropped by the log budget");
+    EXPECT_EQ(number(summary, "dropped"), 5u);
+    EXPECT_EQ(number(summary, "trace"), 0u);
+    EXPECT_EQ(number(summary, "debug"), 5u);
+    EXPECT_EQ(number(summary, "info"), 0u);
+
+    // counted once
+    gtWarning() << "warning";
+    EXPECT_EQ(records.size(), 4u);
+}
+
+// pending summaries do not wait for the next message
+TEST_F(LogBudget, summaryOnFlush)
+{
+    gt::log::LogBudget budget;
+    budget.messagesPerSecond = 1;
+    logger.setBudget(budget);
+
+    gtInfo() << "admitted";
+    gtInfo() << "dropped";
+    gtTrace() << "dropped";
+    EXPECT_EQ(records.size(), 1u);
+
+    logger.flush();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(number(records.back(), "dropped"), 2u);
+    EXPECT_EQ(number(records.back(), "info"), 1u);
+    EXPECT_EQ(number(records.back(), "trace"), 1u);
+
+    logger.flush();
+    EXPECT_EQ(records.size(), 2u);
+
+    // summarized when the budget is replaced
+    gtDebug() << "dropped";
+    logger.setBudget({});
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(number(records.back(), "dropped"), 1u);
+    EXPECT_EQ(number(records.back(), "debug"), 1u);
+
+    gtTrace() << "unlimited";
+    EXPECT_EQ(count(gt::log::TraceLevel), 1u);
+}
+
+TEST_F(LogBudget, concurrent)
+{
+    constexpr int N = 1000;
+
+    gt::log::LogBudget budget;
+    budget.messagesPerSecond = 100;
+    logger.setBudget(budget);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([](){
+            for (int i = 0; i < N; ++i)
+            {
+                gtInfo() << "info" << i;
+                if (i % 100 == 0) gtWarning() << "warning" << i;
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // messages are either logged or dropped, warnings are always logged
+    auto state = logger.budgetState();
+    EXPECT_EQ(count(gt::log::InfoLevel) + state.droppedInfo, 4u * N);
+    EXPECT_GE(count(gt::log::InfoLevel), 90u);
+    EXPECT_GE(count(gt::log::WarningLevel), 4u * N / 100);
+}
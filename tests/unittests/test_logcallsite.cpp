@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// custom module id
+#define GT_MODULE_ID "CallSite"
+
+#include "test_log_helper.h"
+
+#include <algorithm>
+
+class LogCallSite : public LogHelperTest
+{
+    void TearDown() override
+    {
+        logger.clearCallSiteModes();
+        LogHelperTest::TearDown();
+    }
+};
+
+namespace
+{
+
+void traceA() { gtTrace() << "TraceA"; }
+void traceB() { gtTrace() << "TraceB"; }
+
+} // namespace
+
+TEST_F(LogCallSite, enumerate)
+{
+    traceA();
+
+    auto sites = logger.callSites();
+    auto iter = std::find_if(sites.begin(), sites.end(),
+                             [](gt::log::CallSite const& site){
+        return site.level == gt::log::TraceLevel &&
+               site.module == "CallSite" &&
+               site.file.find("test_logcallsite.cpp") != std::string::npos;
+    });
+    ASSERT_NE(iter, sites.end());
+    EXPECT_EQ(iter->mode, gt::log::CallSiteDefault);
+    EXPECT_GT(iter->line, 0);
+}
+
+TEST_F(LogCallSite, enableByLine)
+{
+    traceA();
+    traceB();
+    EXPECT_FALSE(log.contains("Trace"));
+
+    // enable first trace statement only
+    auto sites = logger.callSites();
+    auto iter = std::find_if(sites.begin(), sites.end(),
+                             [](gt::log::CallSite const& site){
+        return site.level == gt::log::TraceLevel && site.module == "CallSite";
+    });
+    ASSERT_NE(iter, sites.end());
+
+    gt::log::CallSiteFilter filter;
+    filter.file = "test_logcallsite.cpp";
+    filter.firstLine = iter->line;
+    filter.lastLine = iter->line;
+    EXPECT_EQ(logger.setCallSiteMode(filter, gt::log::CallSiteEnabled), 1u);
+
+    traceA();
+    traceB();
+    EXPECT_TRUE(log.contains("TraceA"));
+    EXPECT_FALSE(log.contains("TraceB"));
+}
+
+TEST_F(LogCallSite, disableByModule)
+{
+    gt::log::CallSiteFilter filter;
+    filter.module = "Call*";
+    logger.setCallSiteMode(filter, gt::log::CallSiteDisabled);
+
+    gtError() << "Error";
+    gtErrorId("Other") << "Other";
+    EXPECT_FALSE(log.contains("Error"));
+    EXPECT_TRUE(log.contains("Other"));
+
+    logger.clearCallSiteModes();
+    gtError() << "Error";
+    EXPECT_TRUE(log.contains("Error"));
+}
+
+TEST_F(LogCallSite, filterAppliesToNewSites)
+{
+    // the statement below has not been executed yet
+    gt::log::CallSiteFilter filter;
+    filter.file = "unittests/test_logcallsite.cpp";
+    logger.setCallSiteMode(filter, gt::log::CallSiteEnabled);
+
+    gtTrace() << "NewSite";
+    EXPECT_TRUE(log.contains("NewSite"));
+
+    // file names must match entirely
+    logger.clearCallSiteModes();
+    filter.file = "callsite.cpp";
+    EXPECT_EQ(logger.setCallSiteMode(filter, gt::log::CallSiteEnabled), 0u);
+}
+
+// identical filters replace each other, the latest mode applies
+TEST_F(LogCallSite, toggleRepeatedly)
+{
+    gt::log::CallSiteFilter filter;
+    filter.module = "CallSite";
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        logger.setCallSiteMode(filter, i % 2 ? gt::log::CallSiteEnabled :
+                                               gt::log::CallSiteDisabled);
+    }
+
+    // enabled
+    traceA();
+    EXPECT_TRUE(log.contains("TraceA"));
+
+    logger.setCallSiteMode(filter, gt::log::CallSiteDisabled);
+    traceA();
+    traceB();
+    EXPECT_FALSE(log.contains("TraceB"));
+}
+
+// runtime ids use the level of the module the statement was registered with
+TEST_F(LogCallSite, runtimeId)
+{
+    logger.setModuleLoggingLevel("Runtime", gt::log::ErrorLevel);
+
+    auto const logId = [](std::string const& id){
+        gtWarningId(id) << "Warning" << id;
+    };
+
+    logId("Runtime");
+    logId("Other");
+    EXPECT_FALSE(log.contains("Warning Runtime"));
+    EXPECT_TRUE(log.contains("Warning Other"));
+    log.clear();
+
+    logger.setModuleLoggingLevel("Runtime", gt::log::InfoLevel);
+    logger.setModuleLoggingLevel("Other", gt::log::ErrorLevel);
+    logId("Runtime");
+    logId("Other");
+    EXPECT_TRUE(log.contains("Warning Runtime"));
+    EXPECT_FALSE(log.contains("Warning Other"));
+
+    logger.clearModuleLoggingLevels();
+}
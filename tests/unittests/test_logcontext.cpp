@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <thread>
+
+class LogContext : public LogRecordTest {};
+
+TEST_F(LogContext, scopes)
+{
+    gtInfo() << "outside";
+    {
+        gt::log::ScopedContext task{"task", 42};
+        gtInfo() << "task";
+        {
+            gt::log::ScopedContext user{"user", "alice"};
+            gtInfo() << "user";
+        }
+        gtInfo() << "task";
+    }
+    gtInfo() << "outside";
+
+    ASSERT_EQ(records.size(), 5u);
+    EXPECT_TRUE(records[0].details.context.empty());
+    EXPECT_EQ(records[1].details.context.toString(), "task=42");
+    EXPECT_EQ(records[2].details.context.toString(), "task=42 user=alice");
+    EXPECT_EQ(records[3].details.context.toString(), "task=42");
+    EXPECT_TRUE(records[4].details.context.empty());
+
+    ASSERT_NE(records[2].details.context.find("user"), nullptr);
+    EXPECT_EQ(*records[2].details.context.find("user"), "alice");
+    EXPECT_EQ(records[1].details.context.find("user"), nullptr);
+
+    EXPECT_TRUE(gt::log::currentContext().empty());
+}
+
+TEST_F(LogContext, shadowed)
+{
+    gt::log::ScopedContext outer{"task", 1};
+    gt::log::ScopedContext step{"step", "init"};
+    gt::log::ScopedContext inner{"task", 2};
+    gtInfo() << "inner";
+
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].details.context.toString(), "step=init task=2");
+    EXPECT_EQ(*records[0].details.context.find("task"), "2");
+}
+
+// records share the snapshot of the scope
+TEST_F(LogContext, shared)
+{
+    gt::log::ScopedContext task{"task", std::string{"import"}};
+    gtInfo() << "first";
+    gtDebug() << "second";
+
+    ASSERT_EQ(records.size(), 2u);
+    auto const& context = records[0].details.context;
+    EXPECT_EQ(context.node(), records[1].details.context.node());
+    EXPECT_EQ(context.node(), gt::log::currentContext().node());
+}
+
+TEST_F(LogContext, threads)
+{
+    gt::log::ScopedContext task{"task", 1};
+
+    std::thread([](){
+        gtInfo() << "worker";
+        gt::log::ScopedContext task{"task", 2};
+        gtInfo() << "worker";
+    }).join();
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_TRUE(records[0].details.context.empty());
+    EXPECT_EQ(records[1].details.context.toString(), "task=2");
+}
+
+TEST_F(LogContext, async)
+{
+    ASSERT_TRUE(logger.enableAsync());
+    {
+        gt::log::ScopedContext task{"task", 7};
+        gtInfo() << "queued";
+        gtInfoB("binary {}", 1);
+    }
+    // the snapshot outlives the scope
+    logger.flush();
+    logger.disableAsync();
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[0].details.context.toString(), "task=7");
+    EXPECT_EQ(records[1].details.context.toString(), "task=7");
+}
@@ -79,4 +79,6 @@ TEST_F(DestTest, destinations)
     destinations = logger.destinationIds();
     ASSERT_EQ(destinations.size(), 2);
     EXPECT_EQ(destinations.back(), destid);
+
+    EXPECT_TRUE(logger.removeDestination(destid));
 }
@@ -32,3 +32,25 @@ TEST_F(TestDisableLogging, callMemberMethod)
     gtError().nospace() << "This should not be logged too";
     EXPECT_TRUE(log.isEmpty());
 }
+
+// arguments must not be evaluated
+TEST_F(TestDisableLogging, noEvaluation)
+{
+    int evaluated = 0;
+    gtError() << ++evaluated;
+    gtInfoId("LogTest") << ++evaluated;
+    gtLogOnce(Warning) << ++evaluated;
+    gtLogOnceSite(Warning) << ++evaluated;
+    gtLogOnceSiteId(Warning, "LogTest") << ++evaluated;
+    gtErrorV(gt::log::Silent) << ++evaluated;
+    gtInfoIdV("LogTest", gt::log::Silent) << ++evaluated;
+    gtErrorF("{}", ++evaluated);
+    gtInfoIdF("LogTest", "{}", ++evaluated);
+    gtErrorB("{}", ++evaluated);
+    gtErrorRt("{}", ++evaluated);
+    gtWarningEveryN(10) << ++evaluated;
+    gtInfoEveryMs(1000) << ++evaluated;
+    gtErrorFirstN(5) << ++evaluated;
+    gtTraceSampled(1.0) << ++evaluated;
+    EXPECT_EQ(evaluated, 0);
+}
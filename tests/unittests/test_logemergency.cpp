@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+class LogEmergency : public LogHelperTest
+{
+#ifndef _WIN32
+public:
+
+    int pipes[2]{-1, -1};
+
+    void SetUp() override
+    {
+        LogHelperTest::SetUp();
+        ASSERT_EQ(pipe(pipes), 0);
+        ASSERT_TRUE(gt::log::addEmergencyFd(pipes[1]));
+    }
+
+    void TearDown() override
+    {
+        gt::log::removeEmergencyFd(pipes[1]);
+        close(pipes[0]);
+        close(pipes[1]);
+        LogHelperTest::TearDown();
+    }
+
+    //! Returns the data written to the pipe so far
+    std::string written()
+    {
+        char buffer[4096];
+        ssize_t n = read(pipes[0], buffer, sizeof(buffer));
+        return std::string(buffer, n > 0 ? static_cast<size_t>(n) : 0);
+    }
+#endif
+};
+
+#ifndef _WIN32
+
+TEST_F(LogEmergency, stream)
+{
+    void const* p = reinterpret_cast<void const*>(0x1f);
+
+    gt::log::EmergencyStream(gt::log::ErrorLevel)
+        << "signal " << 11 << ' ' << -42 << ' ' << 18446744073709551615ull
+        << ' ' << true << ' ' << p;
+
+    EXPECT_EQ(written(),
+              "ERROR [emergency] signal 11 -42 18446744073709551615 true 0x1f\n");
+
+    // bypasses the logger
+    EXPECT_TRUE(log.isEmpty());
+}
+
+TEST_F(LogEmergency, truncated)
+{
+    {
+        gt::log::EmergencyStream stream;
+        for (int i = 0; i < 1000; ++i) stream << 'x';
+    }
+
+    std::string message = written();
+    EXPECT_EQ(message.size(), size_t{gt::log::EmergencyStream::Capacity});
+    EXPECT_EQ(message.rfind("FATAL [emergency] xxx", 0), 0u);
+    EXPECT_EQ(message.back(), '\n');
+}
+
+TEST_F(LogEmergency, fileDescriptors)
+{
+    // already registered
+    EXPECT_FALSE(gt::log::addEmergencyFd(pipes[1]));
+    EXPECT_FALSE(gt::log::addEmergencyFd(-1));
+
+    int fds = 1;
+    while (gt::log::addEmergencyFd(100 + fds)) ++fds;
+    EXPECT_EQ(fds, static_cast<int>(gt::log::MaxEmergencyFds));
+
+    for (int fd = 101; fd < 100 + fds; ++fd)
+    {
+        EXPECT_TRUE(gt::log::removeEmergencyFd(fd));
+    }
+    EXPECT_FALSE(gt::log::removeEmergencyFd(101));
+}
+
+// messages queued in asynchronous mode are written once the process crashes
+TEST(LogEmergencyDeathTest, crashFlushesPendingMessages)
+{
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+
+    auto crash = [](int sig){
+        auto& logger = gt::log::Logger::instance();
+
+        // slow destination, thus messages are still queued on crash
+        logger.addDestination("stderr", gt::log::makeFunctorDestination(
+            [](std::string const& msg, gt::log::Level, gt::log::Details const&){
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                std::cerr << msg << std::endl;
+        }));
+        logger.enableAsync();
+        logger.installCrashHandler();
+
+        for (int i = 0; i < 50; ++i) gtInfo() << "pending" << i;
+        std::raise(sig);
+    };
+
+    EXPECT_EXIT(crash(SIGABRT), testing::KilledBySignal(SIGABRT),
+                "caught signal 6 \\(SIGABRT\\).*pending 49");
+    EXPECT_EXIT(crash(SIGSEGV), testing::KilledBySignal(SIGSEGV),
+                "caught signal 11 \\(SIGSEGV\\).*pending 49");
+}
+
+#endif
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <string>
+
+class LogField : public LogRecordTest {};
+
+TEST_F(LogField, types)
+{
+    gtInfo() << "converged"
+             << gt::log::field("ok", true)
+             << gt::log::field("iter", -12)
+             << gt::log::field("count", 3u)
+             << gt::log::field("residual", 1e-8)
+             << gt::log::field("solver", "newton")
+             << gt::log::field("name", std::string{"a b"})
+             << gt::log::field("custom", MyStruct{7});
+
+    ASSERT_EQ(records.size(), 1u);
+    auto const& fields = records[0].details.fields;
+    ASSERT_EQ(fields.size(), 7u);
+
+    // not part of the message
+    EXPECT_EQ(records[0].message, "converged ");
+
+    EXPECT_EQ(fields[0].key, "ok");
+    EXPECT_EQ(fields[0].type, gt::log::Field::Bool);
+    EXPECT_TRUE(fields[0].number.b);
+
+    EXPECT_EQ(fields[1].type, gt::log::Field::Int);
+    EXPECT_EQ(fields[1].number.i, -12);
+
+    EXPECT_EQ(fields[2].type, gt::log::Field::UInt);
+    EXPECT_EQ(fields[2].number.u, 3u);
+
+    EXPECT_EQ(fields[3].type, gt::log::Field::Double);
+    EXPECT_EQ(fields[3].number.d, 1e-8);
+    EXPECT_EQ(fields[3].valueToString(), "1e-08");
+
+    EXPECT_EQ(fields[4].type, gt::log::Field::String);
+    EXPECT_EQ(fields[4].text, "newton");
+    EXPECT_EQ(fields[5].text, "a b");
+    EXPECT_EQ(fields[6].text, "MyStruct(7)");
+
+    // text formatters render the fields inline
+    EXPECT_TRUE(log.contains("converged "));
+    EXPECT_FALSE(log.contains("iter"));
+}
+
+TEST_F(LogField, disabled)
+{
+    int evaluated = 0;
+    auto value = [&](){ return ++evaluated; };
+
+    gtTrace() << gt::log::field("value", value());
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_TRUE(records.empty());
+
+    // verbosity is not enabled
+    gt::log::Stream stream;
+    stream.verbose() << gt::log::field("value", 1);
+    EXPECT_TRUE(stream.fields().empty());
+}
+
+TEST_F(LogField, async)
+{
+    ASSERT_TRUE(logger.enableAsync());
+
+    for (int i = 0; i < 3; ++i)
+    {
+        gtInfo() << "step" << gt::log::field("i", i);
+    }
+    gtInfo() << "plain";
+
+    logger.flush();
+    logger.disableAsync();
+
+    ASSERT_EQ(records.size(), 4u);
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(records[i].details.fields.size(), 1u);
+        EXPECT_EQ(records[i].details.fields[0].number.i, i);
+    }
+    // fields of previous records are not reused
+    EXPECT_TRUE(records[3].details.fields.empty());
+}
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include "gt_logging/vector.h"
+
+namespace
+{
+
+// forwards the format string, thus it must be an immediate function as well
+template <typename... Ts>
+GT_LOG_CONSTEVAL gt::log::detail::FormatError validate(char const* fmt)
+{
+    return gt::log::detail::validateFormat(
+        fmt, gt::log::detail::FormatTypeList<Ts...>{});
+}
+
+using namespace gt::log::detail;
+
+// format strings are validated at compile time
+static_assert(validate<>("text") == FormatOk, "");
+static_assert(validate<>("{{escaped}}") == FormatOk, "");
+static_assert(validate<int, double>("x={} y={:.3f}") == FormatOk, "");
+static_assert(validate<int, char const*>("{:>8x} {:<10s}") == FormatOk, "");
+static_assert(validate<int>("{:*>+#08}") == FormatOk, "");
+static_assert(validate<int, int>("{}") == FormatTooManyArguments, "");
+static_assert(validate<int>("{} {}") == FormatMissingArguments, "");
+static_assert(validate<int>("{}}") == FormatUnmatchedBrace, "");
+static_assert(validate<int>("{") == FormatInvalidSpec, "");
+static_assert(validate<int>("{0}") == FormatInvalidSpec, "");
+static_assert(validate<int>("{:^4}") == FormatInvalidSpec, "");
+static_assert(validate<double>("{:x}") == FormatTypeMismatch, "");
+static_assert(validate<int>("{:.2}") == FormatTypeMismatch, "");
+static_assert(validate<std::string>("{:+}") == FormatTypeMismatch, "");
+static_assert(validate<int>("{:s}") == FormatTypeMismatch, "");
+
+} // namespace
+
+class LogFormatString : public LogHelperTest
+{};
+
+TEST_F(LogFormatString, arguments)
+{
+    int x = 42;
+    std::string name{"gt"};
+    gtInfoF("x={} name={} pi={}", x, name, 3.5);
+    EXPECT_TRUE(log.contains("x=42 name=gt pi=3.5"));
+    log.clear();
+
+    gtInfoF("no arguments");
+    EXPECT_TRUE(log.contains("no arguments"));
+    log.clear();
+
+    gtWarningF("{{{}}}", "braces");
+    EXPECT_TRUE(log.contains("{braces}"));
+}
+
+TEST_F(LogFormatString, codeUnits)
+{
+    gtInfoF("{} {}", char16_t{'W'}, char32_t{'L'});
+    EXPECT_TRUE(log.contains("u'87' U'76'"));
+}
+
+TEST_F(LogFormatString, specs)
+{
+    gtInfoF("[{:x}|{:#X}|{:o}|{:+}]", 255, 255, 8, 3);
+    EXPECT_TRUE(log.contains("[ff|0XFF|10|+3]"));
+    log.clear();
+
+    gtInfoF("[{:5}|{:<5}|{:*>5}|{:05}]", 12, 12, 12, -12);
+    EXPECT_TRUE(log.contains("[   12|12   |***12|-0012]"));
+    log.clear();
+
+    gtInfoF("[{:.2f}|{:.3e}|{:.3}|{}]", 3.14159, 1234.5, 2.0 / 3, 0.1);
+    EXPECT_TRUE(log.contains("[3.14|1.234e+03|0.667|0.1]"));
+    log.clear();
+
+    gtInfoF("[{:>6s}|{:<6}]", "ab", std::string{"cd"});
+    EXPECT_TRUE(log.contains("[    ab|cd    ]"));
+}
+
+TEST_F(LogFormatString, specDoesNotLeak)
+{
+    gtInfoF("{:x} {}", 255, 255) << 255;
+    EXPECT_TRUE(log.contains("ff 255 255"));
+}
+
+TEST_F(LogFormatString, streamOverloads)
+{
+    std::vector<int> vec{1, 2, 3};
+    MyStruct custom{7};
+    gtInfoF("vec={} custom={} flag={}", vec, custom, true);
+    EXPECT_TRUE(log.contains("vec=(1, 2, 3) custom=MyStruct(7) flag=true"));
+}
+
+TEST_F(LogFormatString, idAndModule)
+{
+    gtInfoIdF("Format", "{}-{}", 1, 2);
+    EXPECT_TRUE(log.contains("[Format]"));
+    EXPECT_TRUE(log.contains("1-2"));
+}
+
+TEST_F(LogFormatString, noEvaluation)
+{
+    int evaluated = 0;
+    auto eval = [&evaluated](){ return ++evaluated; };
+
+    logger.setLoggingLevel(gt::log::InfoLevel);
+    gtDebugF("{}", eval());
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_TRUE(log.isEmpty());
+
+    gtInfoF("{}", eval());
+    EXPECT_EQ(evaluated, 1);
+    EXPECT_TRUE(log.contains("1"));
+}
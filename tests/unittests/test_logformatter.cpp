@@ -183,3 +183,94 @@ TEST_F(LogFormatter, messageOnly)
     auto err = f.format("my fancy message", gt::log::ErrorLevel, {});
     EXPECT_EQ(err, "ERROR: my fancy message");
 }
+
+TEST_F(LogFormatter, pattern)
+{
+    std::tm time{};
+    time.tm_hour = 12;
+    time.tm_min  = 59;
+    time.tm_sec  = 42;
+
+    gt::log::Formatter f{ gt::log::Formatter::Pattern{"%1 [%2] %4:%5 %6: %7"} };
+
+    auto res = f.format("Hello", gt::log::WarningLevel,
+                        gt::log::Details{"my_id", time,
+                                         {"main.cpp", 42, "run"}});
+    EXPECT_EQ(res, "WARN  [12:59:42] main.cpp:42 run: Hello");
+
+    f.setFormat(gt::log::Formatter::Pattern{"[%9:%8] %7"});
+    res = f.format("Hello", gt::log::InfoLevel,
+                   gt::log::Details{"my_id", time, {}, {1234, "solver"}});
+    EXPECT_EQ(res, "[solver:1234] Hello");
+}
+
+TEST_F(LogFormatter, fields)
+{
+    std::tm time{};
+    time.tm_hour = 12;
+    time.tm_min  = 59;
+    time.tm_sec  = 42;
+    time.tm_mday = 1;
+    time.tm_year = 2077 - 1900;
+
+    gt::log::Details details{"my_id", time};
+    details.fields = {gt::log::field("iter", 12),
+                      gt::log::field("residual", 1e-8),
+                      gt::log::field("solver", "newton raphson")};
+
+    gt::log::Formatter f;
+    EXPECT_EQ(f.format("converged ", gt::log::InfoLevel, details),
+              "INFO  [12:59:42] [my_id] converged iter=12 residual=1e-08 "
+              "solver=\"newton raphson\"");
+
+    f.setFormat(gt::log::Formatter::MessageOnly());
+    EXPECT_EQ(f.format("converged", gt::log::InfoLevel, details),
+              "converged iter=12 residual=1e-08 solver=\"newton raphson\"");
+
+    f.setFormat(gt::log::Formatter::Json());
+    details.fields.push_back(gt::log::field("ok", false));
+    details.fields.push_back(gt::log::field("inf", HUGE_VAL));
+    EXPECT_EQ(f.format("converged", gt::log::InfoLevel, details),
+              "{\"time\":\"2077-01-01T12:59:42\",\"level\":\"INFO\","
+              "\"id\":\"my_id\",\"fields\":{\"iter\":12,\"residual\":1e-08,"
+              "\"solver\":\"newton raphson\",\"ok\":false,\"inf\":\"inf\"},"
+              "\"message\":\"converged\"}");
+}
+
+TEST_F(LogFormatter, json)
+{
+    std::tm time{};
+    time.tm_hour = 12;
+    time.tm_min  = 59;
+    time.tm_sec  = 42;
+    time.tm_mday = 1;
+    time.tm_year = 2077 - 1900;
+
+    gt::log::Formatter f{ gt::log::Formatter::Json() };
+
+    auto res = f.format("say \"hi\"\n\t\\", gt::log::InfoLevel,
+                        gt::log::Details{"my_id", time,
+                                         {"main.cpp", 42, "run"},
+                                         {1234, "solver"}});
+    EXPECT_EQ(res, "{\"time\":\"2077-01-01T12:59:42\",\"level\":\"INFO\","
+                   "\"id\":\"my_id\",\"file\":\"main.cpp\",\"line\":42,"
+                   "\"function\":\"run\",\"thread\":1234,"
+                   "\"threadName\":\"solver\","
+                   "\"message\":\"say \\\"hi\\\"\\n\\t\\\\\"}");
+
+    // id and location are omitted if unknown
+    res = f.format(std::string("\x01", 1), gt::log::ErrorLevel,
+                   gt::log::Details{"", time});
+    EXPECT_EQ(res, "{\"time\":\"2077-01-01T12:59:42\",\"level\":\"ERROR\","
+                   "\"message\":\"\\u0001\"}");
+
+    // diagnostic context as nested object
+    gt::log::ScopedContext task{"task", 42};
+    gt::log::ScopedContext user{"user", "a\"b"};
+    res = f.format("msg", gt::log::InfoLevel,
+                   gt::log::Details{"", time, {}, {},
+                                    gt::log::currentContext()});
+    EXPECT_EQ(res, "{\"time\":\"2077-01-01T12:59:42\",\"level\":\"INFO\","
+                   "\"context\":{\"task\":\"42\",\"user\":\"a\\\"b\"},"
+                   "\"message\":\"msg\"}");
+}
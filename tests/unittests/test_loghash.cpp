@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+
+namespace
+{
+
+std::uint64_t
+xxh64(std::string const& data)
+{
+    gt::log::detail::Hasher hasher;
+    hasher.update(data.data(), data.size());
+    return hasher.digest();
+}
+
+} // namespace
+
+// published test vectors of XXH64 (seed 0)
+TEST(LogHash, referenceValues)
+{
+    EXPECT_EQ(xxh64(""), 0xef46db3751d8e999ull);
+    EXPECT_EQ(xxh64("a"), 0xd24ec4f1a98c6e5bull);
+    EXPECT_EQ(xxh64("abc"), 0x44bc2cf5ad770999ull);
+    EXPECT_EQ(xxh64("Nobody inspects the spammish repetition"),
+              0xfbcea83c8a378bf1ull);
+}
+
+// the digest does not depend on how the data is split
+TEST(LogHash, streaming)
+{
+    std::string data;
+    for (int i = 0; i < 200; ++i) data += static_cast<char>('a' + i % 26);
+
+    std::uint64_t expected = xxh64(data);
+    for (size_t chunk : {1u, 3u, 7u, 31u, 32u, 33u, 100u})
+    {
+        gt::log::detail::Hasher hasher;
+        for (size_t i = 0; i < data.size(); i += chunk)
+        {
+            hasher.update(data.data() + i, std::min(chunk, data.size() - i));
+        }
+        EXPECT_EQ(hasher.digest(), expected) << chunk;
+    }
+}
+
+// message, id and level are kept apart
+TEST(LogHash, distinctInputs)
+{
+    using gt::log::hash;
+
+    EXPECT_EQ(hash("msg", "id", gt::log::InfoLevel),
+              hash("msg", "id", gt::log::InfoLevel));
+
+    EXPECT_NE(hash("ab", "c", gt::log::InfoLevel),
+              hash("a", "bc", gt::log::InfoLevel));
+    EXPECT_NE(hash("msg", "", gt::log::InfoLevel),
+              hash("", "msg", gt::log::InfoLevel));
+    EXPECT_NE(hash("msg", "id", gt::log::InfoLevel),
+              hash("msg", "id", gt::log::WarningLevel));
+    // formerly "msg" + "id1" + "6" and "msg" + "id" + "16"
+    EXPECT_NE(hash("msg", "id1", gt::log::levelFromInt(6)),
+              hash("msg", "id", gt::log::ErrorLevel));
+}
+
+// a collision suppresses a message, thus similar messages must not collide
+TEST(LogHash, noCollisions)
+{
+    if (sizeof(gt::log::hash_t) < 8) GTEST_SKIP() << "32-bit hashes";
+
+    constexpr int count = 100000;
+    std::unordered_set<gt::log::hash_t> hashes;
+    for (int i = 0; i < count; ++i)
+    {
+        hashes.insert(gt::log::hash("value " + std::to_string(i), "Test",
+                                    gt::log::InfoLevel));
+    }
+    EXPECT_EQ(hashes.size(), static_cast<size_t>(count));
+}
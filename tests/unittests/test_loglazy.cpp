@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+class LogLazy : public LogHelperTest
+{
+public:
+    int evaluated = 0;
+
+    auto expensive()
+    {
+        return gt::log::lazy([this](){ return "Value" + std::to_string(++evaluated); });
+    }
+};
+
+TEST_F(LogLazy, evaluatedIfLogged)
+{
+    gtInfo() << "Lazy" << expensive();
+    EXPECT_TRUE(log.contains("Lazy Value1"));
+    EXPECT_EQ(evaluated, 1);
+}
+
+TEST_F(LogLazy, levelAndVerbosity)
+{
+    logger.setLoggingLevel(gt::log::InfoLevel);
+    gtDebug() << expensive();
+
+    logger.setVerbosity(gt::log::Silent);
+    gtInfo().verbose() << expensive();
+
+    EXPECT_EQ(evaluated, 0);
+}
+
+TEST_F(LogLazy, destinationFilter)
+{
+    // no destination accepts warnings
+    ASSERT_TRUE(logger.removeDestination(destid));
+
+    std::vector<gt::log::FormattedDestination*> filtered;
+    for (auto const& id : logger.destinationIds())
+    {
+        auto* dest = dynamic_cast<gt::log::FormattedDestination*>(
+            logger.destination(id));
+        ASSERT_TRUE(dest);
+        dest->filterLevel(gt::log::WarningLevel, false);
+        filtered.push_back(dest);
+    }
+
+    gtWarning() << expensive();
+    EXPECT_EQ(evaluated, 0);
+
+    gtError() << expensive();
+    EXPECT_EQ(evaluated, 1);
+
+    for (auto* dest : filtered) dest->filterLevel(gt::log::WarningLevel);
+}
+
+// checking the destinations does not wait for the backend thread
+TEST_F(LogLazy, doesNotBlockAsync)
+{
+    std::atomic<bool> writing{false};
+    std::atomic<bool> release{false};
+
+    logger.addDestination("slow", gt::log::makeFunctorDestination(
+        [&](std::string const&, gt::log::Level, gt::log::Details const&){
+        writing = true;
+        while (!release) std::this_thread::yield();
+    }));
+    ASSERT_TRUE(logger.enableAsync());
+
+    gtInfo() << "Slow";
+    while (!writing) std::this_thread::yield();
+
+    auto producer = std::async(std::launch::async, [this](){
+        gtInfo() << expensive();
+    });
+    auto status = producer.wait_for(std::chrono::seconds(5));
+
+    release = true;
+    logger.disableAsync();
+    logger.removeDestination("slow");
+
+    EXPECT_EQ(status, std::future_status::ready);
+    EXPECT_EQ(evaluated, 1);
+}
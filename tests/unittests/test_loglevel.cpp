@@ -4,6 +4,8 @@
 
 #include "test_log_helper.h"
 
+#include <thread>
+
 struct LogLevel : public LogHelperTest
 {
     static void testLevel(gt::log::Level level)
@@ -62,3 +64,28 @@ TEST_F(LogLevel, offLevel)
     gtFatal() << "Fatal";
     EXPECT_FALSE(log.contains("Fatal"));
 }
+
+/// level and verbosity may be changed while other threads are logging
+TEST_F(LogLevel, concurrentChanges)
+{
+    using namespace gt::log;
+
+    std::thread worker([](){
+        for (int i = 0; i < 1000; ++i)
+        {
+            gtDebug().medium() << "Concurrent";
+        }
+    });
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        logger.setLoggingLevel(i % 2 ? DebugLevel : InfoLevel);
+        logger.setVerbosity(i % 2 ? Everything : Silent);
+    }
+    worker.join();
+
+    logger.setLoggingLevel(InfoLevel);
+    EXPECT_EQ(logger.loggingLevel(), InfoLevel);
+    logger.setVerbosity(Silent);
+    EXPECT_EQ(logger.verbosity(), Silent);
+}
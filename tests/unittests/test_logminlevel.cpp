@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// strip everything below info level in this file
+#define GT_LOG_MIN_LEVEL gt::log::InfoLevel
+
+#include "test_log_helper.h"
+
+class LogMinLevel : public LogHelperTest
+{};
+
+namespace
+{
+
+int evaluated = 0;
+
+int sideEffect() { return ++evaluated; }
+
+} // namespace
+
+TEST_F(LogMinLevel, stripped)
+{
+    evaluated = 0;
+    logger.setLoggingLevel(gt::log::TraceLevel);
+
+    gtTrace() << "Trace" << sideEffect();
+    gtDebug() << "Debug" << sideEffect();
+    gtDebugId("Test") << "DebugId" << sideEffect();
+    gtLogOnce(Debug) << "DebugOnce" << sideEffect();
+
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_TRUE(log.isEmpty());
+}
+
+TEST_F(LogMinLevel, notStripped)
+{
+    evaluated = 0;
+
+    gtInfo() << "Info" << sideEffect();
+    gtWarningId("Test") << "Warning" << sideEffect();
+
+    EXPECT_EQ(evaluated, 2);
+    EXPECT_TRUE(log.contains("Info"));
+    EXPECT_TRUE(log.contains("Warning"));
+}
+
+TEST_F(LogMinLevel, runtimeLevel)
+{
+    evaluated = 0;
+    logger.setLoggingLevel(gt::log::ErrorLevel);
+
+    // compiled in, but disabled at runtime
+    gtInfo() << "Info" << sideEffect();
+
+    EXPECT_EQ(evaluated, 0);
+    EXPECT_TRUE(log.isEmpty());
+}
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// custom module id
+#define GT_MODULE_ID "gtlab.core.test"
+
+#include "test_log_helper.h"
+
+class LogModuleLevel : public LogHelperTest
+{
+    void TearDown() override
+    {
+        logger.clearModuleLoggingLevels();
+        LogHelperTest::TearDown();
+    }
+};
+
+TEST_F(LogModuleLevel, exactMatch)
+{
+    using namespace gt::log;
+
+    logger.setModuleLoggingLevel("gtlab.core.test", WarningLevel);
+    EXPECT_EQ(logger.moduleLoggingLevel("gtlab.core.test"), WarningLevel);
+    EXPECT_EQ(logger.moduleLoggingLevel("other"), DebugLevel);
+
+    gtInfo() << "Info";
+    gtWarning() << "Warning";
+    EXPECT_FALSE(log.contains("Info"));
+    EXPECT_TRUE(log.contains("Warning"));
+
+    // other modules use the global level
+    gtInfoId("other") << "Other";
+    EXPECT_TRUE(log.contains("Other"));
+}
+
+TEST_F(LogModuleLevel, prefixMatch)
+{
+    using namespace gt::log;
+
+    logger.setModuleLoggingLevel("gtlab.*", ErrorLevel);
+    logger.setModuleLoggingLevel("gtlab.core.*", TraceLevel);
+
+    // longest prefix wins
+    EXPECT_EQ(logger.moduleLoggingLevel("gtlab.core.test"), TraceLevel);
+    EXPECT_EQ(logger.moduleLoggingLevel("gtlab.gui"), ErrorLevel);
+    EXPECT_EQ(logger.moduleLoggingLevel("gtlab"), DebugLevel);
+
+    gtTrace() << "Trace";
+    EXPECT_TRUE(log.contains("Trace"));
+
+    gtWarningId("gtlab.gui") << "Gui";
+    EXPECT_FALSE(log.contains("Gui"));
+
+    // exact match takes precedence
+    logger.setModuleLoggingLevel("gtlab.core.test", FatalLevel);
+    gtError() << "Error";
+    EXPECT_FALSE(log.contains("Error"));
+}
+
+TEST_F(LogModuleLevel, removeOverride)
+{
+    using namespace gt::log;
+
+    logger.setModuleLoggingLevel("gtlab.core.test", OffLevel);
+    gtFatal() << "Fatal";
+    EXPECT_FALSE(log.contains("Fatal"));
+
+    EXPECT_TRUE(logger.removeModuleLoggingLevel("gtlab.core.test"));
+    EXPECT_FALSE(logger.removeModuleLoggingLevel("gtlab.core.test"));
+
+    gtFatal() << "Fatal";
+    EXPECT_TRUE(log.contains("Fatal"));
+}
+
+TEST_F(LogModuleLevel, followsGlobalLevel)
+{
+    using namespace gt::log;
+
+    // modules without override follow the global level
+    gtDebug() << "Debug";
+    EXPECT_TRUE(log.contains("Debug"));
+    log.clear();
+
+    logger.setLoggingLevel(WarningLevel);
+    EXPECT_EQ(logger.moduleLoggingLevel("gtlab.core.test"), WarningLevel);
+
+    gtDebug() << "Debug";
+    EXPECT_FALSE(log.contains("Debug"));
+}
+
+// module levels of runtime ids are cached until a level changes
+TEST_F(LogModuleLevel, runtimeIds)
+{
+    using namespace gt::log;
+
+    logger.setModuleLoggingLevel("gtlab.gui", ErrorLevel);
+
+    auto const logIds = [](){
+        for (std::string id : {"gtlab.gui", "gtlab.mesh"})
+        {
+            gtInfoId(id) << "Runtime" << id;
+        }
+    };
+
+    logIds();
+    EXPECT_FALSE(log.contains("Runtime gtlab.gui"));
+    EXPECT_TRUE(log.contains("Runtime gtlab.mesh"));
+    log.clear();
+
+    logger.setModuleLoggingLevel("gtlab.gui", InfoLevel);
+    logger.setModuleLoggingLevel("gtlab.mesh", ErrorLevel);
+
+    logIds();
+    EXPECT_TRUE(log.contains("Runtime gtlab.gui"));
+    EXPECT_FALSE(log.contains("Runtime gtlab.mesh"));
+    log.clear();
+
+    logger.setLoggingLevel(WarningLevel);
+    logger.removeModuleLoggingLevel("gtlab.gui");
+
+    logIds();
+    EXPECT_FALSE(log.contains("Runtime"));
+}
@@ -5,7 +5,11 @@
 
 #include "test_log_helper.h"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 class LogOnce : public LogHelperTest
 {};
@@ -75,3 +79,126 @@ TEST_F(LogOnce, local_cache)
     EXPECT_EQ(log.count("log once"), 2);
     EXPECT_EQ(localCache.cache.size(), 2);
 }
+
+TEST_F(LogOnce, call_site)
+{
+    int evaluated = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        // the message may differ between executions
+        gtLogOnceSite(Warning) << "site" << ++evaluated;
+    }
+    EXPECT_EQ(log.count("site"), 1);
+    EXPECT_TRUE(log.contains("site 1"));
+    // arguments are not evaluated after the first execution
+    EXPECT_EQ(evaluated, 1);
+
+    // each statement is logged once
+    gtLogOnceSite(Warning) << "site";
+    EXPECT_EQ(log.count("site"), 2);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        gtLogOnceSiteId(Info, "TEST") << "with id";
+    }
+    EXPECT_EQ(log.count("with id"), 1);
+    EXPECT_EQ(log.count("[TEST]"), 1);
+}
+
+TEST_F(LogOnce, call_site_disabled)
+{
+    // disabled executions do not count
+    for (int level : {gt::log::ErrorLevel, gt::log::DebugLevel})
+    {
+        logger.setLoggingLevel(gt::log::levelFromInt(level));
+        gtLogOnceSite(Info) << "enabled later";
+    }
+    EXPECT_EQ(log.count("enabled later"), 1);
+}
+
+TEST_F(LogOnce, default_cache_capacity)
+{
+    gt::log::LogOnceCacheOptions options;
+    options.capacity = 64;
+    gt::log::Logger::DefaultCache cache{options};
+
+    gt::log::hash_t recent = 12345;
+    EXPECT_TRUE(cache.insert(recent));
+    EXPECT_FALSE(cache.insert(recent));
+    EXPECT_TRUE(cache.insert(1));
+
+    for (gt::log::hash_t h = 100; h < 1100; ++h)
+    {
+        EXPECT_TRUE(cache.insert(h));
+        // least recently used entries are evicted first
+        EXPECT_TRUE(cache.find(recent));
+    }
+    EXPECT_LE(cache.size(), 64u);
+    EXPECT_FALSE(cache.find(1));
+
+    // reducing the capacity evicts entries
+    options.capacity = 16;
+    cache.setOptions(options);
+    EXPECT_LE(cache.size(), 16u);
+    EXPECT_TRUE(cache.find(recent));
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST_F(LogOnce, default_cache_time_to_live)
+{
+    gt::log::LogOnceCacheOptions options;
+    options.timeToLive = std::chrono::milliseconds{20};
+    gt::log::Logger::DefaultCache cache{options};
+
+    EXPECT_TRUE(cache.insert(42));
+    EXPECT_FALSE(cache.insert(42));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{30});
+    EXPECT_FALSE(cache.find(42));
+    EXPECT_TRUE(cache.insert(42));
+}
+
+// enabling the time to live later does not expire existing hashes at once
+TEST_F(LogOnce, default_cache_enable_time_to_live)
+{
+    gt::log::Logger::DefaultCache cache;
+    EXPECT_TRUE(cache.insert(42));
+
+    gt::log::LogOnceCacheOptions options;
+    options.timeToLive = std::chrono::milliseconds{50};
+    cache.setOptions(options);
+
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_FALSE(cache.insert(42));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{60});
+    EXPECT_TRUE(cache.insert(42));
+}
+
+TEST_F(LogOnce, default_cache_concurrent)
+{
+    gt::log::Logger::DefaultCache cache;
+    std::atomic<int> inserted{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&](){
+            for (gt::log::hash_t h = 0; h < 1000; ++h)
+            {
+                if (cache.insert(h)) ++inserted;
+            }
+            for (int i = 0; i < 100; ++i)
+            {
+                gtLogOnce(Info, cache) << "concurrent once";
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    // each hash is inserted by exactly one thread
+    EXPECT_EQ(inserted, 1000);
+    EXPECT_EQ(log.count("concurrent once"), 1);
+}
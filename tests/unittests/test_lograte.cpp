@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+class LogRate : public LogRecordTest
+{
+public:
+
+    //! Returns the number of suppressed messages reported by the record
+    std::uint64_t suppressed(size_t i) const
+    {
+        auto const* f = field(records[i], "suppressed");
+        return f ? f->number.u : 0;
+    }
+};
+
+TEST_F(LogRate, everyN)
+{
+    int evaluated = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        gtWarningEveryN(3) << "iteration" << i << ++evaluated;
+    }
+
+    // iterations 0, 3, 6 and 9
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(evaluated, 4);
+
+    EXPECT_EQ(records[0].message, "iteration 0 1 ");
+    EXPECT_EQ(suppressed(0), 0u);
+    EXPECT_EQ(records[1].message, "iteration 3 2 ");
+    EXPECT_EQ(suppressed(1), 2u);
+    EXPECT_EQ(records[3].message, "iteration 9 4 ");
+    EXPECT_EQ(suppressed(3), 2u);
+}
+
+TEST_F(LogRate, firstN)
+{
+    int evaluated = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        gtErrorFirstN(2) << ++evaluated;
+    }
+
+    EXPECT_EQ(records.size(), 2u);
+    EXPECT_EQ(evaluated, 2);
+}
+
+TEST_F(LogRate, everyMs)
+{
+    auto const log = [](){
+        gtInfoEveryMs(100) << "throttled";
+    };
+
+    for (int i = 0; i < 5; ++i) log();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(suppressed(0), 0u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+
+    log();
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_EQ(suppressed(1), 4u);
+}
+
+// disabled executions do not count towards the limit
+TEST_F(LogRate, disabledLevel)
+{
+    auto const log = [](){
+        gtInfoFirstN(1) << "first";
+    };
+
+    logger.setLoggingLevel(gt::log::ErrorLevel);
+    for (int i = 0; i < 3; ++i) log();
+    EXPECT_TRUE(records.empty());
+
+    logger.setLoggingLevel(gt::log::DebugLevel);
+    for (int i = 0; i < 3; ++i) log();
+    EXPECT_EQ(records.size(), 1u);
+}
+
+TEST_F(LogRate, concurrent)
+{
+    auto const log = [](){
+        gtDebugEveryN(10) << "concurrent";
+    };
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&](){
+            for (int i = 0; i < 1000; ++i) log();
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(records.size(), 400u);
+}
@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+class LogRealtime : public LogHelperTest
+{
+public:
+
+    void TearDown() override
+    {
+        logger.releaseRealtimeThread();
+        LogHelperTest::TearDown();
+    }
+};
+
+enum Channel { Left = 1, Right = 2 };
+
+TEST_F(LogRealtime, formattedForDestinations)
+{
+    ASSERT_TRUE(logger.prepareRealtimeThread());
+
+    gtInfoRt("sample {} gain {:.2f} channel {}", 42, 0.5, Right);
+    gtErrorRt("{}", "overrun");
+
+    // records are written by the backend thread
+    logger.flush();
+    EXPECT_TRUE(log.contains("sample 42 gain 0.50 channel 2"));
+    EXPECT_TRUE(log.contains("overrun"));
+}
+
+TEST_F(LogRealtime, unprepared)
+{
+    auto before = logger.realtimeStats().unprepared;
+
+    std::thread([](){ gtInfoRt("dropped {}", 1); }).join();
+
+    logger.flush();
+    EXPECT_FALSE(log.contains("dropped"));
+    EXPECT_EQ(logger.realtimeStats().unprepared, before + 1);
+}
+
+// logs while the thread exits, after its records were released
+struct LogsOnExit
+{
+    bool active = false;
+
+    ~LogsOnExit()
+    {
+        if (active) gtInfoRt("exiting {}", 1);
+    }
+};
+
+TEST_F(LogRealtime, afterThreadExit)
+{
+    auto before = logger.realtimeStats().unprepared;
+
+    std::thread([&](){
+        // constructed first, thus destroyed after the records were released
+        thread_local LogsOnExit onExit;
+        onExit.active = true;
+
+        ASSERT_TRUE(logger.prepareRealtimeThread());
+        gtInfoRt("running {}", 1);
+    }).join();
+
+    logger.flush();
+    EXPECT_TRUE(log.contains("running 1"));
+    EXPECT_FALSE(log.contains("exiting"));
+    EXPECT_EQ(logger.realtimeStats().unprepared, before + 1);
+}
+
+TEST_F(LogRealtime, dropped)
+{
+    auto before = logger.realtimeStats().dropped;
+
+    // capacity is rounded up to a power of two
+    gt::log::RealtimeOptions options;
+    options.capacity = 3;
+
+    std::thread([&](){
+        ASSERT_TRUE(logger.prepareRealtimeThread(options));
+        for (int i = 0; i < 1000; ++i) gtInfoRt("record {}", i);
+    }).join();
+
+    logger.flush();
+    EXPECT_TRUE(log.contains("record 0"));
+
+    // records are either written or dropped
+    auto dropped = logger.realtimeStats().dropped - before;
+    EXPECT_EQ(static_cast<std::uint64_t>(log.count("record")) + dropped, 1000u);
+}
+
+TEST_F(LogRealtime, droppedWhileStalled)
+{
+    auto before = logger.realtimeStats().dropped;
+
+    // stalls the backend thread on the first record until released
+    std::mutex mutex;
+    std::condition_variable released;
+    bool release = false;
+    ASSERT_TRUE(logger.addDestination("stall", gt::log::makeFunctorDestination(
+        [&](std::string const&, gt::log::Level, gt::log::Details const&){
+            std::unique_lock<std::mutex> lock(mutex);
+            released.wait(lock, [&](){ return release; });
+    })));
+
+    gt::log::RealtimeOptions options;
+    options.capacity = 4;
+
+    std::thread([&](){
+        ASSERT_TRUE(logger.prepareRealtimeThread(options));
+        for (int i = 0; i < 1000; ++i) gtInfoRt("record {}", i);
+    }).join();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    released.notify_all();
+
+    logger.flush();
+    logger.removeDestination("stall");
+
+    // the record being written blocks the ring, thus at most four records
+    // were accepted
+    auto dropped = logger.realtimeStats().dropped - before;
+    EXPECT_GE(dropped, 1000u - 4u);
+    EXPECT_EQ(static_cast<std::uint64_t>(log.count("record")) + dropped, 1000u);
+}
+
+TEST_F(LogRealtime, noEvaluation)
+{
+    int evaluated = 0;
+
+    logger.setLoggingLevel(gt::log::InfoLevel);
+    gtDebugRt("{}", ++evaluated);
+    EXPECT_EQ(evaluated, 0);
+}
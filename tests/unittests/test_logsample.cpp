@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// custom module id
+#define GT_MODULE_ID "Sampled"
+
+#include "test_log_helper.h"
+
+class LogSample : public LogRecordTest
+{
+public:
+
+    void SetUp() override
+    {
+        LogRecordTest::SetUp();
+        logger.setLoggingLevel(gt::log::TraceLevel);
+    }
+
+    void TearDown() override
+    {
+        logger.clearModuleSamplingRates();
+        LogRecordTest::TearDown();
+    }
+
+    //! Returns the sample weight attached to the record
+    static double weight(Record const& record)
+    {
+        auto const* f = field(record, "sample_weight");
+        return f ? f->number.d : 0.0;
+    }
+
+    // single statement, thus module rates apply to the same call site
+    void trace(double rate, int& evaluated)
+    {
+        gtTraceSampled(rate) << "sampled" << ++evaluated;
+    }
+};
+
+TEST_F(LogSample, uniform)
+{
+    for (int i = 0; i < 10000; ++i)
+    {
+        double value = gt::log::detail::sampleUniform();
+        ASSERT_GE(value, 0.0);
+        ASSERT_LT(value, 1.0);
+    }
+}
+
+TEST_F(LogSample, fraction)
+{
+    int evaluated = 0;
+    for (int i = 0; i < 20000; ++i) trace(0.1, evaluated);
+
+    // expected 2000, standard deviation about 42
+    EXPECT_GT(records.size(), 1700u);
+    EXPECT_LT(records.size(), 2300u);
+    EXPECT_EQ(evaluated, static_cast<int>(records.size()));
+
+    for (auto const& record : records) EXPECT_DOUBLE_EQ(weight(record), 10.0);
+}
+
+TEST_F(LogSample, bounds)
+{
+    int evaluated = 0;
+    for (int i = 0; i < 100; ++i) trace(0.0, evaluated);
+    EXPECT_TRUE(records.empty());
+    EXPECT_EQ(evaluated, 0);
+
+    for (int i = 0; i < 100; ++i) trace(1.0, evaluated);
+    ASSERT_EQ(records.size(), 100u);
+    EXPECT_DOUBLE_EQ(weight(records.front()), 1.0);
+}
+
+TEST_F(LogSample, disabledLevel)
+{
+    logger.setLoggingLevel(gt::log::DebugLevel);
+
+    int evaluated = 0;
+    for (int i = 0; i < 100; ++i) trace(1.0, evaluated);
+    EXPECT_TRUE(records.empty());
+    EXPECT_EQ(evaluated, 0);
+}
+
+TEST_F(LogSample, moduleRate)
+{
+    int evaluated = 0;
+
+    logger.setModuleSamplingRate("Sampled", 0.0);
+    for (int i = 0; i < 100; ++i) trace(1.0, evaluated);
+    EXPECT_TRUE(records.empty());
+
+    // prefix, clamped to 1
+    logger.setModuleSamplingRate("Samp*", 2.0);
+    EXPECT_TRUE(logger.removeModuleSamplingRate("Sampled"));
+    for (int i = 0; i < 100; ++i) trace(0.0, evaluated);
+    EXPECT_EQ(records.size(), 100u);
+
+    // other modules are not affected
+    logger.setModuleSamplingRate("Other", 0.0);
+    EXPECT_TRUE(logger.removeModuleSamplingRate("Samp*"));
+    EXPECT_FALSE(logger.removeModuleSamplingRate("Samp*"));
+    for (int i = 0; i < 100; ++i) trace(1.0, evaluated);
+    EXPECT_EQ(records.size(), 200u);
+}
@@ -0,0 +1,138 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// custom module id
+#define GT_MODULE_ID "Scoped"
+
+#include "test_log_helper.h"
+
+#include <thread>
+
+class LogScopedLevel : public LogHelperTest
+{
+public:
+
+    void SetUp() override
+    {
+        LogHelperTest::SetUp();
+        logger.setLoggingLevel(gt::log::InfoLevel);
+        logger.setVerbosity(gt::log::Silent);
+    }
+
+    void TearDown() override
+    {
+        logger.clearModuleLoggingLevels();
+        logger.clearCallSiteModes();
+        logger.setVerbosity(gt::log::Silent);
+        LogHelperTest::TearDown();
+
+        // all scopes were destroyed
+        EXPECT_FALSE(gt::log::detail::hasThreadOverrides());
+    }
+};
+
+TEST_F(LogScopedLevel, currentThreadOnly)
+{
+    {
+        gt::log::ScopedLevel lvl{gt::log::DebugLevel};
+        gtDebug() << "Scoped";
+
+        std::thread([](){ gtDebug() << "Worker"; }).join();
+    }
+    gtDebug() << "Restored";
+
+    EXPECT_TRUE(log.contains("Scoped"));
+    EXPECT_FALSE(log.contains("Worker"));
+    EXPECT_FALSE(log.contains("Restored"));
+    EXPECT_EQ(logger.loggingLevel(), gt::log::InfoLevel);
+}
+
+TEST_F(LogScopedLevel, nested)
+{
+    gt::log::ScopedLevel debug{gt::log::DebugLevel};
+    {
+        // may reduce the level as well
+        gt::log::ScopedLevel error{gt::log::ErrorLevel};
+        gtWarning() << "Inner";
+    }
+    gtDebug() << "Outer";
+
+    EXPECT_FALSE(log.contains("Inner"));
+    EXPECT_TRUE(log.contains("Outer"));
+}
+
+TEST_F(LogScopedLevel, allMacros)
+{
+    gt::log::ScopedLevel lvl{gt::log::DebugLevel};
+
+    gtDebugId("Other") << "Id";
+    gtDebugF("Format {}", 1);
+    std::string id = "Runtime";
+    gtDebugId(id) << "RuntimeId";
+
+    EXPECT_TRUE(log.contains("Id"));
+    EXPECT_TRUE(log.contains("Format 1"));
+    EXPECT_TRUE(log.contains("RuntimeId"));
+}
+
+TEST_F(LogScopedLevel, replacesModuleLevels)
+{
+    logger.setModuleLoggingLevel("Scoped", gt::log::ErrorLevel);
+    logger.setModuleLoggingLevel("Runtime", gt::log::ErrorLevel);
+
+    gt::log::ScopedLevel lvl{gt::log::DebugLevel};
+    gtDebug() << "Module";
+    std::string id = "Runtime";
+    gtDebugId(id) << "RuntimeId";
+
+    EXPECT_TRUE(log.contains("Module"));
+    EXPECT_TRUE(log.contains("RuntimeId"));
+}
+
+// other threads keep their module levels while a thread overrides its level
+TEST_F(LogScopedLevel, otherThreadsKeepModuleLevels)
+{
+    logger.setModuleLoggingLevel("Runtime", gt::log::DebugLevel);
+
+    gt::log::ScopedLevel lvl{gt::log::ErrorLevel};
+
+    std::thread([](){
+        std::string id = "Runtime";
+        gtDebugId(id) << "RuntimeId";
+        std::string other = "Other";
+        gtDebugId(other) << "OtherId";
+    }).join();
+
+    EXPECT_TRUE(log.contains("RuntimeId"));
+    EXPECT_FALSE(log.contains("OtherId"));
+}
+
+TEST_F(LogScopedLevel, callSiteModesApply)
+{
+    gt::log::CallSiteFilter filter;
+    filter.module = "Scoped";
+    logger.setCallSiteMode(filter, gt::log::CallSiteDisabled);
+
+    gt::log::ScopedLevel lvl{gt::log::DebugLevel};
+    gtError() << "Disabled";
+    EXPECT_FALSE(log.contains("Disabled"));
+}
+
+TEST_F(LogScopedLevel, verbosity)
+{
+    {
+        gt::log::ScopedVerbosity v{gt::log::Everything};
+        gtInfoV(gt::log::Everything) << "Verbose";
+        gtInfo().medium() << "Medium";
+
+        std::thread([](){
+            gtInfoV(gt::log::Everything) << "Worker";
+        }).join();
+    }
+    gtInfoV(gt::log::Everything) << "Restored";
+
+    EXPECT_TRUE(log.contains("Verbose"));
+    EXPECT_TRUE(log.contains("Medium"));
+    EXPECT_FALSE(log.contains("Worker"));
+    EXPECT_FALSE(log.contains("Restored"));
+}
@@ -0,0 +1,86 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+static_assert(gt::log::detail::fileNameOffset("dir/sub\\file.cpp") == 8,
+              "file name must be computed at compile time");
+static_assert(gt::log::detail::fileNameOffset("file.cpp") == 0, "");
+
+class LogSourceLocation : public LogRecordTest {};
+
+namespace
+{
+
+void logFromFunction()
+{
+    gtInfo() << "in function";
+}
+
+} // namespace
+
+TEST_F(LogSourceLocation, captured)
+{
+    gtWarning() << "hello"; int line = __LINE__;
+    logFromFunction();
+
+    ASSERT_EQ(records.size(), 2u);
+
+    EXPECT_STREQ(records[0].details.location.file,
+                 "test_logsourcelocation.cpp");
+    EXPECT_EQ(records[0].details.location.line, line);
+    EXPECT_STREQ(records[0].details.location.function, "TestBody");
+
+    EXPECT_STREQ(records[1].details.location.function, "logFromFunction");
+    EXPECT_EQ(records[1].message, "in function ");
+
+    // not part of the message
+    EXPECT_FALSE(log.contains("test_logsourcelocation"));
+}
+
+TEST_F(LogSourceLocation, allMacros)
+{
+    gtDebugId("Id") << "id"; int line = __LINE__;
+    gtInfoV(gt::log::Silent) << "verbose";
+    gtInfoF("{}", "format");
+    gtLogOnce(Info) << "once";
+    gtLogOnceId(Info, "Id") << "once id";
+
+    ASSERT_EQ(records.size(), 5u);
+    for (auto const& record : records)
+    {
+        EXPECT_STREQ(record.details.location.file,
+                     "test_logsourcelocation.cpp");
+        EXPECT_EQ(record.details.location.line, line++);
+    }
+}
+
+TEST_F(LogSourceLocation, async)
+{
+    ASSERT_TRUE(logger.enableAsync());
+    gtInfo() << "async"; int line = __LINE__;
+    logger.flush();
+    logger.disableAsync();
+
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].details.location.line, line);
+}
+
+TEST_F(LogSourceLocation, binary)
+{
+    gtInfoB("binary {}", 1); int line = __LINE__;
+
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_STREQ(records[0].details.location.file,
+                 "test_logsourcelocation.cpp");
+    EXPECT_EQ(records[0].details.location.line, line);
+}
+
+TEST_F(LogSourceLocation, unknown)
+{
+    logger.log(gt::log::InfoLevel, "direct");
+
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_STREQ(records[0].details.location.file, "");
+    EXPECT_EQ(records[0].details.location.line, 0);
+}
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <climits>
+#include <sstream>
+
+class LogStream : public LogHelperTest
+{};
+
+namespace
+{
+
+struct Nested
+{
+    int i = 0;
+};
+
+// logs using another stream while being formatted
+std::ostream& operator<<(std::ostream& o, Nested const& n)
+{
+    gt::log::Stream inner;
+    inner << std::hex << 255;
+    return o << "Nested(" << n.i << ", " << inner.message() << ")";
+}
+
+} // namespace
+
+TEST_F(LogStream, integers)
+{
+    gt::log::Stream s;
+    s << 0 << -5 << INT_MIN << LLONG_MIN << ULLONG_MAX << short(-3);
+
+    EXPECT_EQ(s.message(), "0 -5 -2147483648 -9223372036854775808 "
+                           "18446744073709551615 -3 ");
+}
+
+TEST_F(LogStream, manipulators)
+{
+    gt::log::Stream s;
+    s << std::hex << 255 << std::dec << 10
+      << std::setw(5) << 7 << 8
+      << std::setprecision(3) << 3.14159
+      << std::noboolalpha << true;
+
+    EXPECT_EQ(s.message(), "ff 10     7 8 3.14 1 ");
+}
+
+TEST_F(LogStream, nestedFormatting)
+{
+    gt::log::Stream s;
+    s << std::setprecision(2);
+    s.doLog(Nested{3}) << 1.234;
+
+    EXPECT_EQ(s.message(), "Nested(3, ff ) 1.2 ");
+}
+
+TEST_F(LogStream, move)
+{
+    gt::log::Stream s;
+    s << "Hello";
+
+    gt::log::Stream moved{std::move(s)};
+    moved << "World";
+
+    EXPECT_EQ(moved.message(), "Hello World ");
+    EXPECT_TRUE(s.message().empty());
+}
+
+TEST_F(LogStream, integerFormats)
+{
+    gt::log::Stream s;
+    s << std::hex << std::showbase << -1 << std::uppercase << 255u
+      << std::oct << 8 << std::nouppercase << std::noshowbase << std::dec
+      << std::left << std::setw(4) << 7 << std::internal << std::setw(5) << -3
+      << std::setbase(16) << 171;
+
+    EXPECT_EQ(s.message(), "0xffffffff 0XFF 010 7    -   3 ab ");
+}
+
+TEST_F(LogStream, floatingPoint)
+{
+    std::vector<double> values = {
+        0.0, -0.0, 0.1, 1.0 / 3, 2.5, 99.95, 1e-5, 123456789.0, 1e22, 5e-324,
+        1.7976931348623157e308
+    };
+
+    auto check = [](double value, auto manip){
+        gt::log::Stream s;
+        s.nospace() << manip << value << ' ' << static_cast<float>(value);
+
+        std::ostringstream os;
+        os.imbue(std::locale::classic());
+        os << manip << value << ' ' << static_cast<float>(value);
+
+        EXPECT_EQ(s.message(), os.str());
+    };
+
+    for (double value : values)
+    {
+        check(value, std::setprecision(6));
+        check(value, std::setprecision(0));
+        check(value, std::setprecision(15));
+        check(value, std::setprecision(17));
+        check(value, std::fixed);
+        check(value, std::scientific);
+        check(value, std::uppercase);
+        check(value, std::showpos);
+        check(value, std::setw(12));
+    }
+}
+
+TEST_F(LogStream, roundtrip)
+{
+    gt::log::Stream s;
+    s << 0.1 << 1.0 / 3 << gt::log::roundtrip
+      << 0.1 << 1.0 / 3 << 1e23 << 0.1f << 1e-7 << std::fixed << 1e-7;
+
+    EXPECT_EQ(s.message(), "0.1 0.333333 0.1 0.3333333333333333 1e+23 0.1 "
+                           "1e-07 0.0000001 ");
+
+    // state saver restores the flag
+    gt::log::Stream t;
+    {
+        gt::log::StreamStateSaver saver{t};
+        t.roundtrip() << 0.1f;
+    }
+    t << 1.0 / 3;
+    EXPECT_EQ(t.message(), "0.1 0.333333 ");
+}
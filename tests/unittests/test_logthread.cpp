@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "test_log_helper.h"
+
+#include <thread>
+
+class LogThread : public LogRecordTest
+{
+public:
+
+    void TearDown() override
+    {
+        gt::log::setThreadName({});
+        LogRecordTest::TearDown();
+    }
+};
+
+TEST_F(LogThread, id)
+{
+    gtInfo() << "main";
+    std::thread([](){ gtInfo() << "worker"; }).join();
+    gtInfo() << "main";
+
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_NE(records[0].details.thread.id, 0u);
+    EXPECT_NE(records[0].details.thread.id, records[1].details.thread.id);
+    EXPECT_EQ(records[0].details.thread.id, records[2].details.thread.id);
+    EXPECT_EQ(records[0].details.thread.id, gt::log::currentThread().id);
+
+    // cached per thread
+    EXPECT_EQ(&gt::log::currentThread(), &gt::log::currentThread());
+}
+
+TEST_F(LogThread, name)
+{
+    gtInfo() << "unnamed";
+    gt::log::setThreadName("main");
+    gtInfo() << "named";
+
+    ASSERT_EQ(records.size(), 2u);
+    EXPECT_STREQ(records[0].details.thread.name, "");
+    EXPECT_STREQ(records[1].details.thread.name, "main");
+}
+
+TEST_F(LogThread, async)
+{
+    ASSERT_TRUE(logger.enableAsync());
+
+    std::uint64_t workerId = 0;
+    std::thread([&](){
+        gt::log::setThreadName("solver-1");
+        workerId = gt::log::currentThread().id;
+        gtInfo() << "worker";
+        gtInfoB("binary {}", 1);
+    }).join();
+
+    // the names remain valid after the thread has exited
+    logger.flush();
+    logger.disableAsync();
+
+    ASSERT_EQ(records.size(), 2u);
+    for (auto const& record : records)
+    {
+        EXPECT_EQ(record.details.thread.id, workerId);
+        EXPECT_STREQ(record.details.thread.name, "solver-1");
+    }
+}
+
+TEST_F(LogThread, realtime)
+{
+    std::thread([&](){
+        gt::log::setThreadName("audio");
+        ASSERT_TRUE(logger.prepareRealtimeThread());
+        gtInfoRt("realtime {}", 1);
+    }).join();
+
+    logger.flush();
+
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_STREQ(records[0].details.thread.name, "audio");
+}
@@ -225,6 +225,12 @@ TEST_F(TypesQt, Strings)
     EXPECT_TRUE(log.contains("Test"));
 }
 
+TEST_F(TypesQt, formatString)
+{
+    gtInfoF("{}={}", QString{"list"}, QStringList{"Hallo", "Welt"});
+    EXPECT_TRUE(log.contains("list=(Hallo, Welt)"));
+}
+
 TEST_F(TypesQt, QStringRef)
 {
     QString qstr = "MyFancyString";
@@ -71,3 +71,39 @@ TEST_F(Verbosity, logErrorVerboseMediumSuccess2)
     EXPECT_TRUE(log.contains("This verbose error should still appear"));
 }
 
+
+TEST_F(Verbosity, evaluatedOncePerStatement)
+{
+    ASSERT_TRUE(log.isEmpty());
+
+    logger.setVerbosity(gt::log::Medium);
+
+    // changing the verbosity does not affect a statement that already started
+    gtError().medium() << "Begin"
+                       << (logger.setVerbosity(gt::log::Silent), "End");
+    EXPECT_TRUE(log.contains("Begin End"));
+
+    gtError().medium() << "Skipped";
+    EXPECT_FALSE(log.contains("Skipped"));
+}
+
+TEST_F(Verbosity, verboseMacros)
+{
+    ASSERT_TRUE(log.isEmpty());
+
+    logger.setVerbosity(gt::log::Medium);
+
+    int evaluated = 0;
+    auto expensive = [&](){ return ++evaluated; };
+
+    gtErrorV(gt::log::Everything) << "Suppressed" << expensive();
+    gtErrorIdV("Id", 7) << "Suppressed" << expensive();
+    EXPECT_FALSE(log.contains("Suppressed"));
+    EXPECT_EQ(evaluated, 0);
+
+    gtErrorV(gt::log::Medium) << "Verbose" << expensive();
+    gtErrorIdV("Id", 1) << "VerboseId";
+    EXPECT_TRUE(log.contains("Verbose 1"));
+    EXPECT_TRUE(log.contains("[Id]"));
+    EXPECT_EQ(evaluated, 1);
+}
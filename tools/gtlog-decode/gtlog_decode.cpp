@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2023, German Aerospace Center (DLR)
+// SPDX-License-Identifier: BSD-3-Clause
+
+// Renders a binary log file (".gtlogb") into the text the default formatter
+// would have produced.
+//
+// usage: gtlog-decode <file.gtlogb> [output file]
+
+#include "gt_logging.h"
+
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "usage: gtlog-decode <file.gtlogb> [output file]\n";
+        return 2;
+    }
+
+    std::ifstream in(argv[1], std::ios::in | std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "gtlog-decode: cannot open '" << argv[1] << "'\n";
+        return 1;
+    }
+
+    std::ofstream file;
+    if (argc == 3)
+    {
+        file.open(argv[2]);
+        if (!file)
+        {
+            std::cerr << "gtlog-decode: cannot open '" << argv[2] << "'\n";
+            return 1;
+        }
+    }
+    std::ostream& out = argc == 3 ? file : std::cout;
+
+    gt::log::Formatter formatter;
+    bool ok = gt::log::readBinaryLog(in, [&](std::string const& message,
+                                             gt::log::Level level,
+                                             gt::log::Details const& details){
+        out << formatter.format(message, level, details) << '\n';
+    });
+
+    if (!ok)
+    {
+        std::cerr << "gtlog-decode: '" << argv[1]
+                  << "' is not a valid binary log or is truncated\n";
+        return 1;
+    }
+    return 0;
+}